@@ -1,10 +1,14 @@
 #include <vector>
 #include <string>
 #include <cassert>
+#include <format>
+#include <algorithm>
+#include <bit>
 #include "ecsact/runtime/meta.hh"
 #include "ecsact/codegen/plugin.h"
 #include "ecsact/codegen/plugin.hh"
 #include "ecsact/lang-support/lang-cc.hh"
+#include "ecsact/cpp_codegen_plugin_util.hh"
 
 constexpr auto GENERATED_FILE_DISCLAIMER = R"(// GENERATED FILE - DO NOT EDIT
 )";
@@ -66,40 +70,910 @@ static auto cpp_field_type_name(ecsact_field_type field_type) -> std::string {
 	}
 }
 
+static void write_field(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id,
+	ecsact_field_id                 field_id,
+	std::string_view                indentation
+) {
+	auto field_type = ecsact_meta_field_type(compo_id, field_id);
+	auto field_name = ecsact_meta_field_name(compo_id, field_id);
+
+	ctx.writef(
+		"{}{} {}",
+		indentation,
+		cpp_field_type_name(field_type),
+		field_name
+	);
+
+	if(field_type.length > 1) {
+		ctx.writef("[{}]", field_type.length);
+	}
+	ctx.writef(";\n");
+}
+
+/**
+ * Writes the fields in declaration order. That is the order the runtime copies
+ * component data in, so the generated struct must not reorder them.
+ */
 static void write_fields(
 	ecsact::codegen_plugin_context& ctx,
 	ecsact_composite_id             compo_id,
 	std::string_view                indentation
 ) {
 	using ecsact::cc_lang_support::cpp_identifier;
-	using ecsact::cc_lang_support::cpp_type_str;
 	using namespace std::string_literals;
 
 	auto full_name =
 		ecsact_meta_decl_full_name(ecsact_id_cast<ecsact_decl_id>(compo_id));
 
 	for(auto field_id : get_field_ids(compo_id)) {
+		write_field(ctx, compo_id, field_id, indentation);
+	}
+
+	ctx.writef(
+		"{}auto operator<=>(const {}&) const = default;\n",
+		indentation,
+		cpp_identifier(full_name)
+	);
+}
+
+static auto builtin_type_enum_name(ecsact_builtin_type type) -> const char* {
+	switch(type) {
+		case ECSACT_BOOL:
+			return "ECSACT_BOOL";
+		case ECSACT_I8:
+			return "ECSACT_I8";
+		case ECSACT_U8:
+			return "ECSACT_U8";
+		case ECSACT_I16:
+			return "ECSACT_I16";
+		case ECSACT_U16:
+			return "ECSACT_U16";
+		case ECSACT_I32:
+			return "ECSACT_I32";
+		case ECSACT_U32:
+			return "ECSACT_U32";
+		case ECSACT_F32:
+			return "ECSACT_F32";
+		case ECSACT_ENTITY_TYPE:
+			return "ECSACT_ENTITY_TYPE";
+	}
+
+	return "ECSACT_I32";
+}
+
+static auto type_kind_enum_name(ecsact_type_kind kind) -> const char* {
+	switch(kind) {
+		case ECSACT_TYPE_KIND_BUILTIN:
+			return "ECSACT_TYPE_KIND_BUILTIN";
+		case ECSACT_TYPE_KIND_ENUM:
+			return "ECSACT_TYPE_KIND_ENUM";
+		case ECSACT_TYPE_KIND_FIELD_INDEX:
+			return "ECSACT_TYPE_KIND_FIELD_INDEX";
+	}
+
+	return "ECSACT_TYPE_KIND_BUILTIN";
+}
+
+/**
+ * Builtin type a field is stored as. Field index fields are resolved to the
+ * indexed field and enums are stored as `int32_t`.
+ */
+static auto storage_builtin_type( //
+	ecsact_field_type field_type
+) -> ecsact_builtin_type {
+	switch(field_type.kind) {
+		case ECSACT_TYPE_KIND_BUILTIN:
+			return field_type.type.builtin;
+		case ECSACT_TYPE_KIND_ENUM:
+			return ECSACT_I32;
+		case ECSACT_TYPE_KIND_FIELD_INDEX:
+			return storage_builtin_type(ecsact_meta_field_type(
+				field_type.type.field_index.composite_id,
+				field_type.type.field_index.field_id
+			));
+	}
+
+	return ECSACT_I32;
+}
+
+/**
+ * Writes `static constexpr auto fields()` returning a tuple of
+ * `ecsact::field_info` (see ecsact/cpp/type_info.hh) in declaration order. Only
+ * available with ECSACT_CPP_TYPE_INFO so generated headers don't depend on
+ * type_info.hh otherwise.
+ */
+static void write_fields_info(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id,
+	std::string_view                struct_name,
+	std::string_view                indentation
+) {
+	auto field_ids = get_field_ids(compo_id);
+
+	ctx.writef("#ifdef ECSACT_CPP_TYPE_INFO\n");
+	ctx.writef("{}static constexpr auto fields() {{\n", indentation);
+	if(field_ids.empty()) {
+		ctx.writef("{}\treturn std::tuple<>{{}};\n", indentation);
+		ctx.writef("{}}}\n", indentation);
+		ctx.writef("#endif\n");
+		return;
+	}
+
+	ctx.writef("{}\treturn std::tuple{{\n", indentation);
+	for(auto field_id : field_ids) {
 		auto field_type = ecsact_meta_field_type(compo_id, field_id);
 		auto field_name = ecsact_meta_field_name(compo_id, field_id);
+		auto member_type = cpp_field_type_name(field_type);
+		if(field_type.length > 1) {
+			member_type += std::format("[{}]", field_type.length);
+		}
+
+		auto is_entity = field_type.kind == ECSACT_TYPE_KIND_BUILTIN &&
+			field_type.type.builtin == ECSACT_ENTITY_TYPE;
 
 		ctx.writef(
-			"{}{} {}",
+			"{}\t\t::ecsact::field_info<{}, {}>{{\n",
+			indentation,
+			struct_name,
+			member_type
+		);
+		ctx.writef(
+			"{}\t\t\t.id = static_cast<ecsact_field_id>({}),\n",
+			indentation,
+			static_cast<int32_t>(field_id)
+		);
+		ctx.writef("{}\t\t\t.name = \"{}\",\n", indentation, field_name);
+		ctx.writef(
+			"{}\t\t\t.member = &{}::{},\n",
+			indentation,
+			struct_name,
+			field_name
+		);
+		ctx.writef(
+			"{}\t\t\t.offset = offsetof({}, {}),\n",
 			indentation,
-			cpp_field_type_name(field_type),
+			struct_name,
 			field_name
 		);
+		ctx.writef(
+			"{}\t\t\t.kind = {},\n",
+			indentation,
+			type_kind_enum_name(field_type.kind)
+		);
+		ctx.writef(
+			"{}\t\t\t.builtin = {},\n",
+			indentation,
+			builtin_type_enum_name(storage_builtin_type(field_type))
+		);
+		ctx.writef(
+			"{}\t\t\t.length = {},\n",
+			indentation,
+			std::max(field_type.length, 1)
+		);
+		ctx.writef(
+			"{}\t\t\t.entity = {},\n",
+			indentation,
+			is_entity ? "true" : "false"
+		);
+		ctx.writef(
+			"{}\t\t\t.field_index = {},\n",
+			indentation,
+			field_type.kind == ECSACT_TYPE_KIND_FIELD_INDEX ? "true" : "false"
+		);
+		ctx.writef("{}\t\t}},\n", indentation);
+	}
+	ctx.writef("{}\t}};\n", indentation);
+	ctx.writef("{}}}\n", indentation);
+	ctx.writef("#endif\n");
+}
 
-		if(field_type.length > 1) {
-			ctx.writef("[{}]", field_type.length);
+/**
+ * Serialization members of a composite. The serialized form is the field bytes
+ * in member order without padding. When the struct has no padding that is
+ * exactly the struct bytes and a single memcpy is used.
+ */
+static auto serialization_members(
+	ecsact_composite_id compo_id,
+	std::string_view    indentation
+) -> std::string {
+	using ecsact::cpp_codegen_plugin_util::get_composite_layout;
+	using ecsact::cpp_codegen_plugin_util::get_composite_layout_hash;
+
+	auto layout = get_composite_layout(compo_id, false);
+	auto result = std::format(
+		"{}static constexpr std::uint64_t layout_hash = {:#x}ull;\n",
+		indentation,
+		get_composite_layout_hash(compo_id, false)
+	);
+
+	auto copy_fields = [&](bool write) {
+		if(layout.padding == 0) {
+			result += std::format(
+				"{}\t{}\n",
+				indentation,
+				write ? "std::memcpy(out.data(), this, serialized_size);"
+							: "std::memcpy(this, in.data(), serialized_size);"
+			);
+			return;
+		}
+
+		auto offset = std::size_t{0};
+		for(auto& field : layout.fields) {
+			auto field_name = ecsact_meta_field_name(compo_id, field.field_id);
+			if(write) {
+				result += std::format(
+					"{0}\tstd::memcpy(out.data() + {1}, &this->{2}, "
+					"sizeof(this->{2}));\n",
+					indentation,
+					offset,
+					field_name
+				);
+			} else {
+				result += std::format(
+					"{0}\tstd::memcpy(&this->{2}, in.data() + {1}, "
+					"sizeof(this->{2}));\n",
+					indentation,
+					offset,
+					field_name
+				);
+			}
+			offset += field.size;
+		}
+	};
+
+	result += std::format(
+		"{0}auto serialize(std::span<std::byte> out) const -> std::size_t {{\n"
+		"{0}\tif(out.size() < serialized_size) {{\n"
+		"{0}\t\treturn 0;\n"
+		"{0}\t}}\n",
+		indentation
+	);
+	copy_fields(true);
+	result += std::format(
+		"{0}\treturn serialized_size;\n"
+		"{0}}}\n",
+		indentation
+	);
+
+	result += std::format(
+		"{0}auto deserialize(std::span<const std::byte> in) -> std::size_t {{\n"
+		"{0}\tif(in.size() < serialized_size) {{\n"
+		"{0}\t\treturn 0;\n"
+		"{0}\t}}\n",
+		indentation
+	);
+	copy_fields(false);
+	result += std::format(
+		"{0}\treturn serialized_size;\n"
+		"{0}}}\n",
+		indentation
+	);
+
+	return result;
+}
+
+/**
+ * Writes `layout_hash`, `serialized_size` and the `serialize`/`deserialize`
+ * members.
+ */
+static void write_serialization(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id,
+	std::string_view                indentation
+) {
+	using ecsact::cpp_codegen_plugin_util::get_composite_layout;
+
+	auto layout = get_composite_layout(compo_id, false);
+	ctx.writef(
+		"{}static constexpr std::size_t serialized_size = {};\n",
+		indentation,
+		layout.size - layout.padding
+	);
+
+	ctx.writef("{}", serialization_members(compo_id, indentation));
+}
+
+/**
+ * Writes `has_padding` and `hash_append(ecsact::hash_state&)` which hashes the
+ * field bytes while skipping padding. `hash_append` is only written with
+ * ECSACT_CPP_HASH. Must be written after the serialization members.
+ */
+static void write_hash_append(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id,
+	std::string_view                indentation
+) {
+	using ecsact::cpp_codegen_plugin_util::get_composite_layout;
+
+	auto layout = get_composite_layout(compo_id, false);
+	ctx.writef(
+		"{}static constexpr bool has_padding = {};\n",
+		indentation,
+		layout.padding != 0 ? "true" : "false"
+	);
+
+	ctx.writef("#ifdef ECSACT_CPP_HASH\n");
+	if(layout.fields.empty()) {
+		ctx.writef(
+			"{0}auto hash_append(::ecsact::hash_state&) const -> void {{\n"
+			"{0}}}\n",
+			indentation
+		);
+		ctx.writef("#endif\n");
+		return;
+	}
+
+	ctx.writef(
+		"{}auto hash_append(::ecsact::hash_state& state) const -> void {{\n",
+		indentation
+	);
+	if(layout.padding == 0) {
+		ctx.writef("{}\tstate.append_bytes(this, sizeof(*this));\n", indentation);
+	} else {
+		// Gather the fields without padding so they are hashed in one pass
+		ctx.writef(
+			"{0}\tstd::byte bytes[serialized_size];\n"
+			"{0}\tserialize(bytes);\n"
+			"{0}\tstate.append_bytes(bytes, serialized_size);\n",
+			indentation
+		);
+	}
+	ctx.writef("{}}}\n", indentation);
+	ctx.writef("#endif\n");
+}
+
+/**
+ * Writes `bitwise_equal` and, when no field is a float, an `operator==` using
+ * it. `bitwise_equal` compares field bytes and skips padding so floats compare
+ * by representation: `-0.0f` and `0.0f` differ while identical NaNs are equal.
+ * Structs with floats keep the defaulted (IEEE) `operator==`.
+ */
+static void write_equality(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id,
+	std::string_view                struct_name,
+	std::string_view                indentation
+) {
+	using ecsact::cpp_codegen_plugin_util::get_composite_layout;
+
+	auto field_ids = get_field_ids(compo_id);
+	if(field_ids.empty()) {
+		return;
+	}
+
+	auto layout = get_composite_layout(compo_id, false);
+	ctx.writef(
+		"{0}static auto bitwise_equal(const {1}& a, const {1}& b) -> bool {{\n",
+		indentation,
+		struct_name
+	);
+
+	if(layout.padding == 0) {
+		ctx.writef(
+			"{}\treturn std::memcmp(&a, &b, sizeof({})) == 0;\n",
+			indentation,
+			struct_name
+		);
+	} else {
+		ctx.writef("{}\treturn", indentation);
+		for(auto i = 0; layout.fields.size() > i; ++i) {
+			ctx.writef(
+				"{0}std::memcmp(&a.{1}, &b.{1}, sizeof(a.{1})) == 0",
+				i == 0 ? " " : " &&\n" + std::string{indentation} + "\t\t",
+				ecsact_meta_field_name(compo_id, layout.fields[i].field_id)
+			);
 		}
 		ctx.writef(";\n");
 	}
+	ctx.writef("{}}}\n", indentation);
+
+	auto has_float_field = std::ranges::any_of(field_ids, [&](auto field_id) {
+		auto field_type = ecsact_meta_field_type(compo_id, field_id);
+		return storage_builtin_type(field_type) == ECSACT_F32;
+	});
+
+	if(!has_float_field) {
+		// bitwise_equal uses memcmp which isn't allowed in constant expressions,
+		// those use the defaulted operator<=> instead
+		ctx.writef(
+			"{0}constexpr auto operator==(const {1}& other) const -> bool {{\n"
+			"{0}\tif(std::is_constant_evaluated()) {{\n"
+			"{0}\t\treturn (*this <=> other) == 0;\n"
+			"{0}\t}}\n"
+			"{0}\treturn bitwise_equal(*this, other);\n"
+			"{0}}}\n",
+			indentation,
+			struct_name
+		);
+	}
+}
 
+/**
+ * Writes `std::hash` specialization for a generated struct. Must be written
+ * outside of any namespace.
+ */
+static void write_std_hash(
+	ecsact::codegen_plugin_context& ctx,
+	std::string_view                full_type_name
+) {
+	ctx.writef("template<>\n");
+	ctx.writef("struct std::hash<{}> {{\n", full_type_name);
 	ctx.writef(
-		"{}auto operator<=>(const {}&) const = default;\n",
+		"\tauto operator()(const {}& value) const noexcept -> std::size_t {{\n",
+		full_type_name
+	);
+	ctx.writef(
+		"\t\treturn static_cast<std::size_t>(::ecsact::hash_value(value));\n"
+	);
+	ctx.writef("\t}}\n");
+	ctx.writef("}};\n");
+}
+
+/**
+ * Writes `diff`, `delta_size`, `encode_delta` and `apply_delta`. Bit `i` of a
+ * field mask refers to the `i`th field in declaration order. Encoded deltas
+ * start with the mask in little endian (one byte per 8 fields) followed by the
+ * bytes of each changed field. Composites without fields or with more fields
+ * than fit in a mask get no delta members.
+ */
+static void write_delta(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id,
+	std::string_view                struct_name,
+	std::string_view                indentation
+) {
+	auto field_ids = get_field_ids(compo_id);
+	if(field_ids.empty() || field_ids.size() > 64) {
+		return;
+	}
+
+	auto field_names = std::vector<std::string>{};
+	for(auto field_id : field_ids) {
+		field_names.emplace_back(ecsact_meta_field_name(compo_id, field_id));
+	}
+
+	const auto mask_bytes = (field_ids.size() + 7) / 8;
+	ctx.writef(
+		"{}static constexpr std::size_t delta_mask_size = {};\n",
 		indentation,
-		cpp_identifier(full_name)
+		mask_bytes
 	);
+
+	ctx.writef(
+		"{0}static auto diff(const {1}& old, const {1}& now) -> std::uint64_t {{\n"
+		"{0}\tauto mask = std::uint64_t{{}};\n",
+		indentation,
+		struct_name
+	);
+	for(auto i = 0; field_names.size() > i; ++i) {
+		ctx.writef(
+			"{0}\tif(std::memcmp(&old.{1}, &now.{1}, sizeof(old.{1})) != 0) {{\n"
+			"{0}\t\tmask |= std::uint64_t{{1}} << {2};\n"
+			"{0}\t}}\n",
+			indentation,
+			field_names[i],
+			i
+		);
+	}
+	ctx.writef("{0}\treturn mask;\n{0}}}\n", indentation);
+
+	ctx.writef(
+		"{0}static constexpr auto delta_size(std::uint64_t mask) "
+		"-> std::size_t {{\n"
+		"{0}\tauto size = delta_mask_size;\n",
+		indentation
+	);
+	for(auto i = 0; field_names.size() > i; ++i) {
+		ctx.writef(
+			"{0}\tif(mask & (std::uint64_t{{1}} << {1})) {{\n"
+			"{0}\t\tsize += sizeof({2}::{3});\n"
+			"{0}\t}}\n",
+			indentation,
+			i,
+			struct_name,
+			field_names[i]
+		);
+	}
+	ctx.writef("{0}\treturn size;\n{0}}}\n", indentation);
+
+	ctx.writef(
+		"{0}auto encode_delta(std::uint64_t mask, std::span<std::byte> out) "
+		"const -> std::size_t {{\n"
+		"{0}\tif(out.size() < delta_size(mask)) {{\n"
+		"{0}\t\treturn 0;\n"
+		"{0}\t}}\n"
+		"{0}\tfor(std::size_t i = 0; delta_mask_size > i; ++i) {{\n"
+		"{0}\t\tout[i] = static_cast<std::byte>(mask >> (i * 8));\n"
+		"{0}\t}}\n"
+		"{0}\tauto _offset = delta_mask_size;\n",
+		indentation
+	);
+	for(auto i = 0; field_names.size() > i; ++i) {
+		ctx.writef(
+			"{0}\tif(mask & (std::uint64_t{{1}} << {1})) {{\n"
+			"{0}\t\tstd::memcpy(out.data() + _offset, &this->{2}, "
+			"sizeof(this->{2}));\n"
+			"{0}\t\t_offset += sizeof(this->{2});\n"
+			"{0}\t}}\n",
+			indentation,
+			i,
+			field_names[i]
+		);
+	}
+	ctx.writef("{0}\treturn _offset;\n{0}}}\n", indentation);
+
+	ctx.writef(
+		"{0}auto apply_delta(std::span<const std::byte> in) -> std::size_t {{\n"
+		"{0}\tif(in.size() < delta_mask_size) {{\n"
+		"{0}\t\treturn 0;\n"
+		"{0}\t}}\n"
+		"{0}\tauto _mask = std::uint64_t{{}};\n"
+		"{0}\tfor(std::size_t i = 0; delta_mask_size > i; ++i) {{\n"
+		"{0}\t\t_mask |= static_cast<std::uint64_t>(in[i]) << (i * 8);\n"
+		"{0}\t}}\n"
+		"{0}\tif(in.size() < delta_size(_mask)) {{\n"
+		"{0}\t\treturn 0;\n"
+		"{0}\t}}\n"
+		"{0}\tauto _offset = delta_mask_size;\n",
+		indentation
+	);
+	for(auto i = 0; field_names.size() > i; ++i) {
+		ctx.writef(
+			"{0}\tif(_mask & (std::uint64_t{{1}} << {1})) {{\n"
+			"{0}\t\tstd::memcpy(&this->{2}, in.data() + _offset, "
+			"sizeof(this->{2}));\n"
+			"{0}\t\t_offset += sizeof(this->{2});\n"
+			"{0}\t}}\n",
+			indentation,
+			i,
+			field_names[i]
+		);
+	}
+	ctx.writef("{0}\treturn _offset;\n{0}}}\n", indentation);
+}
+
+/**
+ * Number of bits needed to store every declared value of @p enum_id offset by
+ * the smallest value, and that smallest value.
+ */
+static auto enum_bit_range(ecsact_enum_id enum_id)
+	-> std::pair<int, std::int64_t> {
+	auto values = ecsact::meta::get_enum_values(enum_id);
+	if(values.empty()) {
+		return {0, 0};
+	}
+
+	auto min_value = std::int64_t{values.front().value};
+	auto max_value = std::int64_t{values.front().value};
+	for(auto& value : values) {
+		min_value = std::min<std::int64_t>(min_value, value.value);
+		max_value = std::max<std::int64_t>(max_value, value.value);
+	}
+
+	auto bits = std::bit_width(static_cast<std::uint64_t>(max_value - min_value));
+	return {static_cast<int>(bits), min_value};
+}
+
+/**
+ * Writes the packed bit encoding of a single (non array) value. @p expr refers
+ * to the value being encoded or decoded.
+ */
+static auto packed_value_code(
+	ecsact_field_type field_type,
+	std::string_view  expr,
+	bool              encode
+) -> std::string {
+	if(field_type.kind == ECSACT_TYPE_KIND_ENUM) {
+		auto [bits, min_value] = enum_bit_range(field_type.type.enum_id);
+		auto type_name = cpp_field_type_name(field_type);
+		if(bits == 0) {
+			// Only one possible value, nothing to write
+			if(encode) {
+				return "";
+			}
+			return std::format(
+				"{} = static_cast<{}>({});",
+				expr,
+				type_name,
+				min_value
+			);
+		}
+
+		if(encode) {
+			return std::format(
+				"writer.write_bits(static_cast<std::uint64_t>("
+				"static_cast<std::int64_t>({}) - ({})), {});",
+				expr,
+				min_value,
+				bits
+			);
+		}
+
+		return std::format(
+			"{} = static_cast<{}>("
+			"static_cast<std::int64_t>(reader.read_bits({})) + ({}));",
+			expr,
+			type_name,
+			bits,
+			min_value
+		);
+	}
+
+	auto builtin = storage_builtin_type(field_type);
+	if(builtin == ECSACT_BOOL) {
+		return encode ? std::format("writer.write_bool({});", expr)
+									: std::format("{} = reader.read_bool();", expr);
+	}
+
+	if(builtin == ECSACT_F32) {
+		return encode ? std::format("writer.write_f32({});", expr)
+									: std::format("{} = reader.read_f32();", expr);
+	}
+
+	if(builtin == ECSACT_ENTITY_TYPE) {
+		if(encode) {
+			return std::format(
+				"writer.write_varint(static_cast<std::int32_t>({}));",
+				expr
+			);
+		}
+		return std::format(
+			"{} = static_cast<::ecsact_entity_id>(reader.read_varint());",
+			expr
+		);
+	}
+
+	auto bits = ecsact::cpp_codegen_plugin_util::builtin_type_size(builtin) * 8;
+	auto type_name = std::string{ecsact::cc_lang_support::cpp_type_str(builtin)};
+	if(encode) {
+		return std::format(
+			"writer.write_bits(static_cast<std::make_unsigned_t<{}>>({}), {});",
+			type_name,
+			expr,
+			bits
+		);
+	}
+
+	return std::format(
+		"{} = static_cast<{}>(reader.read_bits({}));",
+		expr,
+		type_name,
+		bits
+	);
+}
+
+/**
+ * Writes `encode_packed`/`decode_packed` (ECSACT_CPP_PACKED_WIRE_FORMAT). Bools
+ * take a single bit, enums the minimum number of bits for their declared value
+ * range and entities are varint encoded. Other builtins keep their full width.
+ */
+static void write_packed_wire_format(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id,
+	std::string_view                indentation
+) {
+	if(ecsact_meta_count_fields(compo_id) == 0) {
+		return;
+	}
+
+	auto write_fn_body = [&](bool encode) {
+		for(auto field_id : get_field_ids(compo_id)) {
+			auto field_type = ecsact_meta_field_type(compo_id, field_id);
+			auto field_name = std::string{ecsact_meta_field_name(compo_id, field_id)};
+			if(field_type.length > 1) {
+				auto code = packed_value_code(field_type, "value", encode);
+				if(code.empty()) {
+					continue;
+				}
+				ctx.writef(
+					"{0}\tfor({1}auto& value : this->{2}) {{\n"
+					"{0}\t\t{3}\n"
+					"{0}\t}}\n",
+					indentation,
+					encode ? "const " : "",
+					field_name,
+					code
+				);
+			} else {
+				auto code =
+					packed_value_code(field_type, "this->" + field_name, encode);
+				if(code.empty()) {
+					continue;
+				}
+				ctx.writef("{}\t{}\n", indentation, code);
+			}
+		}
+	};
+
+	ctx.writef("#ifdef ECSACT_CPP_PACKED_WIRE_FORMAT\n");
+	ctx.writef(
+		"{}auto encode_packed(::ecsact::bit_writer& writer) const -> void {{\n",
+		indentation
+	);
+	write_fn_body(true);
+	ctx.writef("{}}}\n", indentation);
+	ctx.writef(
+		"{}auto decode_packed(::ecsact::bit_reader& reader) -> void {{\n",
+		indentation
+	);
+	write_fn_body(false);
+	ctx.writef("{}}}\n", indentation);
+	ctx.writef("#endif\n");
+}
+
+/**
+ * Guards the struct size the generator computed. The same number is written
+ * as the `declared` size by the layout report code generator.
+ */
+static void write_layout_static_assert(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id,
+	std::string_view                struct_name
+) {
+	using ecsact::cpp_codegen_plugin_util::get_composite_layout;
+
+	ctx.writef(
+		"static_assert(std::is_trivially_copyable_v<{}>);\n",
+		struct_name
+	);
+	ctx.writef(
+		"static_assert(sizeof({0}) == {1}, \"{0} is expected to be {1} bytes\");\n",
+		struct_name,
+		get_composite_layout(compo_id, false).size
+	);
+}
+
+static void write_soa_types_decl(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id
+) {
+	if(ecsact_meta_count_fields(compo_id) == 0) {
+		return;
+	}
+
+	ctx.writef("#ifdef ECSACT_CPP_SOA_TYPES\n");
+	ctx.writef("\tstruct soa_view;\n");
+	ctx.writef("\ttemplate<std::size_t N>\n");
+	ctx.writef("\tstruct soa;\n");
+	ctx.writef("#endif\n");
+}
+
+/**
+ * Writes the struct-of-arrays companion types of a component. `soa<N>` owns one
+ * aligned array per field and `soa_view` points into such arrays. The view
+ * converts between the AoS and SoA representations with `gather`/`scatter`.
+ * The view keeps its column pointers in a nested `columns` struct so field
+ * names can't collide with the view's own members.
+ */
+static void write_soa_types(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id,
+	std::string_view                struct_name
+) {
+	auto field_ids = get_field_ids(compo_id);
+	if(field_ids.empty()) {
+		return;
+	}
+
+	auto for_each_field = [&](auto&& fn) {
+		for(auto field_id : field_ids) {
+			auto field_type = ecsact_meta_field_type(compo_id, field_id);
+			auto field_name = ecsact_meta_field_name(compo_id, field_id);
+			fn(cpp_field_type_name(field_type), field_name, field_type.length);
+		}
+	};
+
+	ctx.writef("#ifdef ECSACT_CPP_SOA_TYPES\n");
+	ctx.writef("struct {}::soa_view {{\n", struct_name);
+	ctx.writef("\tstd::size_t size;\n\n");
+	ctx.writef("\tstruct columns_type {{\n");
+	for_each_field([&](auto type_name, auto field_name, auto length) {
+		if(length > 1) {
+			ctx.writef("\t\t{} (*{})[{}];\n", type_name, field_name, length);
+		} else {
+			ctx.writef("\t\t{}* {};\n", type_name, field_name);
+		}
+	});
+	ctx.writef("\t}} columns;\n");
+
+	ctx.writef("\n\ttemplate<std::size_t N>\n");
+	ctx.writef("\tstatic auto of(soa<N>& arrays) -> soa_view {{\n");
+	ctx.writef("\t\tauto result = soa_view{{N, {{}}}};\n");
+	for_each_field([&](auto, auto field_name, auto) {
+		ctx.writef("\t\tresult.columns.{0} = arrays.{0};\n", field_name);
+	});
+	ctx.writef("\t\treturn result;\n");
+	ctx.writef("\t}}\n");
+
+	ctx.writef("\n\tauto get(std::size_t i) const -> {} {{\n", struct_name);
+	ctx.writef("\t\tauto value = {}{{}};\n", struct_name);
+	for_each_field([&](auto, auto field_name, auto length) {
+		if(length > 1) {
+			ctx.writef(
+				"\t\tstd::memcpy(value.{0}, columns.{0}[i], sizeof(value.{0}));\n",
+				field_name
+			);
+		} else {
+			ctx.writef("\t\tvalue.{0} = columns.{0}[i];\n", field_name);
+		}
+	});
+	ctx.writef("\t\treturn value;\n");
+	ctx.writef("\t}}\n");
+
+	ctx.writef(
+		"\n\tauto set(std::size_t i, const {}& value) const -> void {{\n",
+		struct_name
+	);
+	for_each_field([&](auto, auto field_name, auto length) {
+		if(length > 1) {
+			ctx.writef(
+				"\t\tstd::memcpy(columns.{0}[i], value.{0}, sizeof(value.{0}));\n",
+				field_name
+			);
+		} else {
+			ctx.writef("\t\tcolumns.{0}[i] = value.{0};\n", field_name);
+		}
+	});
+	ctx.writef("\t}}\n");
+
+	ctx.writef(
+		"\n\t/** Copy `src` (AoS) into the arrays of this view (SoA). */\n"
+		"\tauto gather(std::span<const {}> src) const -> void {{\n"
+		"\t\tconst auto count = src.size() < size ? src.size() : size;\n",
+		struct_name
+	);
+	for_each_field([&](auto, auto field_name, auto length) {
+		ctx.writef("\t\tfor(std::size_t i = 0; count > i; ++i) {{\n");
+		if(length > 1) {
+			ctx.writef(
+				"\t\t\tstd::memcpy(columns.{0}[i], src[i].{0}, sizeof(src[i].{0}));\n",
+				field_name
+			);
+		} else {
+			ctx.writef("\t\t\tcolumns.{0}[i] = src[i].{0};\n", field_name);
+		}
+		ctx.writef("\t\t}}\n");
+	});
+	ctx.writef("\t}}\n");
+
+	ctx.writef(
+		"\n\t/** Copy the arrays of this view (SoA) into `dst` (AoS). */\n"
+		"\tauto scatter(std::span<{}> dst) const -> void {{\n"
+		"\t\tconst auto count = dst.size() < size ? dst.size() : size;\n",
+		struct_name
+	);
+	for_each_field([&](auto, auto field_name, auto length) {
+		ctx.writef("\t\tfor(std::size_t i = 0; count > i; ++i) {{\n");
+		if(length > 1) {
+			ctx.writef(
+				"\t\t\tstd::memcpy(dst[i].{0}, columns.{0}[i], sizeof(dst[i].{0}));\n",
+				field_name
+			);
+		} else {
+			ctx.writef("\t\t\tdst[i].{0} = columns.{0}[i];\n", field_name);
+		}
+		ctx.writef("\t\t}}\n");
+	});
+	ctx.writef("\t}}\n");
+	ctx.writef("}};\n");
+
+	ctx.writef("template<std::size_t N>\n");
+	ctx.writef("struct {}::soa {{\n", struct_name);
+	for_each_field([&](auto type_name, auto field_name, auto length) {
+		ctx.writef(
+			"\talignas(ECSACT_CPP_SOA_ALIGNMENT) {} {}[N]",
+			type_name,
+			field_name
+		);
+		if(length > 1) {
+			ctx.writef("[{}]", length);
+		}
+		ctx.writef(";\n");
+	});
+	ctx.writef("}};\n");
+	ctx.writef("#endif\n");
 }
 
 static void write_system_impl_decl(
@@ -110,6 +984,29 @@ static void write_system_impl_decl(
 	ctx.writef("{}static void impl(context&);\n", indentation);
 }
 
+static void write_system_soa_batch_decl(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_system_id                sys_id,
+	std::string_view                indentation
+) {
+	using ecsact::cc_lang_support::c_identifier;
+	using ecsact::cpp_codegen_plugin_util::soa_batch_columns;
+
+	if(soa_batch_columns(sys_id).empty()) {
+		return;
+	}
+
+	ctx.writef("#ifdef ECSACT_CPP_SOA_BATCH\n");
+	ctx.writef("{}struct batch_context;\n", indentation);
+	ctx.writef(
+		"#	ifdef ECSACT_CPP_SOA_BATCH_{}\n",
+		c_identifier(ecsact::meta::decl_full_name(sys_id))
+	);
+	ctx.writef("{}static void batch_impl(batch_context&);\n", indentation);
+	ctx.writef("#	endif\n");
+	ctx.writef("#endif\n");
+}
+
 static void write_system_struct(
 	ecsact::codegen_plugin_context& ctx,
 	ecsact_system_id                sys_id,
@@ -127,6 +1024,7 @@ static void write_system_struct(
 			write_system_struct(ctx, child_system_id, indentation + "\t");
 		}
 		write_system_impl_decl(ctx, indentation + "\t");
+		write_system_soa_batch_decl(ctx, sys_id, indentation + "\t");
 		ctx.writef("{}}};\n", indentation);
 	} else {
 		ctx.writef("{}struct {} {{\n", indentation, anonymous_system_name(sys_id));
@@ -179,9 +1077,32 @@ void ecsact_codegen_plugin(
 	ctx.writef("#pragma once\n\n");
 
 	ctx.writef("#include <cstdint>\n");
+	ctx.writef("#include <tuple>\n");
+	ctx.writef("#include <cstddef>\n");
+	ctx.writef("#include <cstring>\n");
+	ctx.writef("#include <span>\n");
+	ctx.writef("#include <type_traits>\n");
 	ctx.writef("#include <compare>\n");
 	ctx.writef("#include \"ecsact/runtime/common.h\"\n");
 	ctx.writef("\n");
+	ctx.writef("#ifdef ECSACT_CPP_HASH\n");
+	ctx.writef("#	include \"ecsact/cpp/hash.hh\"\n");
+	ctx.writef("#endif\n");
+	ctx.writef("#ifdef ECSACT_CPP_TYPE_INFO\n");
+	ctx.writef("#	include \"ecsact/cpp/type_info.hh\"\n");
+	ctx.writef("#endif\n");
+	ctx.writef("#ifdef ECSACT_CPP_PACKED_WIRE_FORMAT\n");
+	ctx.writef("#	include \"ecsact/cpp/bit_stream.hh\"\n");
+	ctx.writef("#endif\n");
+	ctx.writef("#ifdef ECSACT_CPP_SOA_TYPES\n");
+	ctx.writef("#	include <span>\n");
+	ctx.writef("#	include <cstddef>\n");
+	ctx.writef("#	include <cstring>\n");
+	ctx.writef("#	ifndef ECSACT_CPP_SOA_ALIGNMENT\n");
+	ctx.writef("#		define ECSACT_CPP_SOA_ALIGNMENT 64\n");
+	ctx.writef("#	endif\n");
+	ctx.writef("#endif\n");
+	ctx.writef("\n");
 
 	const auto namespace_str =
 		cpp_identifier(ecsact_meta_package_name(ctx.package_id));
@@ -210,7 +1131,25 @@ void ecsact_codegen_plugin(
 		);
 		write_constexpr_id(ctx, "ecsact_component_id", comp_id, "\t");
 		write_fields(ctx, compo_id, "\t"s);
+		write_fields_info(
+			ctx,
+			compo_id,
+			ecsact_meta_component_name(comp_id),
+			"\t"
+		);
+		write_serialization(ctx, compo_id, "\t");
+		write_hash_append(ctx, compo_id, "\t");
+		write_equality(ctx, compo_id, ecsact_meta_component_name(comp_id), "\t");
+		write_delta(ctx, compo_id, ecsact_meta_component_name(comp_id), "\t");
+		write_packed_wire_format(ctx, compo_id, "\t");
+		write_soa_types_decl(ctx, compo_id);
 		ctx.writef("}};\n");
+		write_layout_static_assert(
+			ctx,
+			compo_id,
+			ecsact_meta_component_name(comp_id)
+		);
+		write_soa_types(ctx, compo_id, ecsact_meta_component_name(comp_id));
 	}
 
 	for(auto comp_id : get_transient_ids(ctx.package_id)) {
@@ -223,7 +1162,22 @@ void ecsact_codegen_plugin(
 		);
 		write_constexpr_id(ctx, "ecsact_transient_id", comp_id, "\t");
 		write_fields(ctx, compo_id, "\t"s);
+		write_fields_info(
+			ctx,
+			compo_id,
+			ecsact_meta_transient_name(comp_id),
+			"\t"
+		);
+		write_serialization(ctx, compo_id, "\t");
+		write_hash_append(ctx, compo_id, "\t");
+		write_equality(ctx, compo_id, ecsact_meta_transient_name(comp_id), "\t");
+		write_delta(ctx, compo_id, ecsact_meta_transient_name(comp_id), "\t");
 		ctx.writef("}};\n");
+		write_layout_static_assert(
+			ctx,
+			compo_id,
+			ecsact_meta_transient_name(comp_id)
+		);
 	}
 
 	for(auto action_id : get_action_ids(ctx.package_id)) {
@@ -239,7 +1193,23 @@ void ecsact_codegen_plugin(
 		}
 		write_system_impl_decl(ctx, "\t");
 		write_fields(ctx, compo_id, "\t");
+		write_fields_info(
+			ctx,
+			compo_id,
+			ecsact_meta_action_name(action_id),
+			"\t"
+		);
+		write_serialization(ctx, compo_id, "\t");
+		write_hash_append(ctx, compo_id, "\t");
+		write_equality(ctx, compo_id, ecsact_meta_action_name(action_id), "\t");
+		write_delta(ctx, compo_id, ecsact_meta_action_name(action_id), "\t");
+		write_packed_wire_format(ctx, compo_id, "\t");
 		ctx.writef("}};\n");
+		write_layout_static_assert(
+			ctx,
+			compo_id,
+			ecsact_meta_action_name(action_id)
+		);
 	}
 
 	for(auto sys_id : get_system_ids(ctx.package_id)) {
@@ -251,4 +1221,23 @@ void ecsact_codegen_plugin(
 	}
 
 	ctx.writef("\n}}// namespace {}\n", namespace_str);
+
+	auto hashed_ids = std::vector<ecsact_composite_id>{};
+	for(auto comp_id : get_component_ids(ctx.package_id)) {
+		hashed_ids.push_back(ecsact_id_cast<ecsact_composite_id>(comp_id));
+	}
+	for(auto trans_id : get_transient_ids(ctx.package_id)) {
+		hashed_ids.push_back(ecsact_id_cast<ecsact_composite_id>(trans_id));
+	}
+	for(auto action_id : get_action_ids(ctx.package_id)) {
+		hashed_ids.push_back(ecsact_id_cast<ecsact_composite_id>(action_id));
+	}
+
+	ctx.writef("\n#ifdef ECSACT_CPP_HASH\n");
+	for(auto compo_id : hashed_ids) {
+		auto full_name =
+			ecsact_meta_decl_full_name(ecsact_id_cast<ecsact_decl_id>(compo_id));
+		write_std_hash(ctx, cpp_identifier(full_name));
+	}
+	ctx.writef("#endif\n");
 }
@@ -0,0 +1,92 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ecsact/runtime/meta.hh"
+#include "ecsact/codegen/plugin.h"
+#include "ecsact/codegen/plugin.hh"
+#include "ecsact/cpp_codegen_plugin_util.hh"
+
+static void write_layout(
+	ecsact::codegen_plugin_context&                          ctx,
+	ecsact_composite_id                                      compo_id,
+	const ecsact::cpp_codegen_plugin_util::composite_layout& layout
+) {
+	ctx.writef(
+		"{{\"size\": {}, \"alignment\": {}, \"padding\": {}, \"fields\": [",
+		layout.size,
+		layout.alignment,
+		layout.padding
+	);
+
+	for(auto i = 0; layout.fields.size() > i; ++i) {
+		auto& field = layout.fields[i];
+		ctx.writef(
+			"{}{{\"name\": \"{}\", \"offset\": {}, \"size\": {}}}",
+			i == 0 ? "" : ", ",
+			ecsact::meta::field_name(compo_id, field.field_id),
+			field.offset,
+			field.size
+		);
+	}
+
+	ctx.writef("]}}");
+}
+
+static void write_composite(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_composite_id             compo_id,
+	std::string_view                kind,
+	bool                            first
+) {
+	using ecsact::cpp_codegen_plugin_util::get_composite_layout;
+
+	ctx.writef(
+		"{}\n\t\t{{\n\t\t\t\"name\": \"{}\",\n\t\t\t\"kind\": \"{}\",\n",
+		first ? "" : ",",
+		ecsact::meta::decl_full_name(compo_id),
+		kind
+	);
+
+	ctx.writef("\t\t\t\"declared\": ");
+	write_layout(ctx, compo_id, get_composite_layout(compo_id, false));
+	ctx.writef(",\n\t\t\t\"packed\": ");
+	write_layout(ctx, compo_id, get_composite_layout(compo_id, true));
+	ctx.writef("\n\t\t}}");
+}
+
+void ecsact_codegen_plugin(
+	ecsact_package_id          package_id,
+	ecsact_codegen_write_fn_t  write_fn,
+	ecsact_codegen_report_fn_t report_fn
+) {
+	using ecsact::meta::get_action_ids;
+	using ecsact::meta::get_component_ids;
+	using ecsact::meta::get_transient_ids;
+
+	ecsact::codegen_plugin_context ctx{package_id, 0, write_fn, report_fn};
+
+	auto first = true;
+	auto write_next = [&](auto id, std::string_view kind) {
+		write_composite(ctx, ecsact_id_cast<ecsact_composite_id>(id), kind, first);
+		first = false;
+	};
+
+	ctx.writef(
+		"{{\n\t\"package\": \"{}\",\n\t\"composites\": [",
+		ecsact::meta::package_name(package_id)
+	);
+
+	for(auto comp_id : get_component_ids(package_id)) {
+		write_next(comp_id, "component");
+	}
+
+	for(auto trans_id : get_transient_ids(package_id)) {
+		write_next(trans_id, "transient");
+	}
+
+	for(auto action_id : get_action_ids(package_id)) {
+		write_next(action_id, "action");
+	}
+
+	ctx.writef("\n\t]\n}}\n");
+}
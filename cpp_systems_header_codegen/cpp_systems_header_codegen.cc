@@ -5,7 +5,10 @@
 #include <string_view>
 #include <ranges>
 #include <set>
+#include <map>
 #include <format>
+#include <iterator>
+#include <algorithm>
 #include "ecsact/runtime/meta.hh"
 #include "ecsact/codegen/plugin.h"
 #include "ecsact/codegen/plugin.hh"
@@ -56,20 +59,15 @@ static void insert_prefix(std::string& str, std::string_view prefix) {
 	}
 }
 
-static auto write_static_assert_codegen_error(
+static auto write_static_assert_codegen_check(
 	ecsact::codegen_plugin_context& ctx,
+	std::string_view                constexpr_condition,
 	std::string_view                err_title,
-	std::string                     err_msg,
-	std::string                     constexpr_err_type = "T"
+	std::string                     err_msg
 ) -> void {
 	word_wrap(err_msg, 78);
 
-	ctx.writef("// local type to make static assert always fail\n");
-	ctx.writef("struct codegen_error {{}};\n");
-	ctx.writef(
-		"static_assert(std::is_same_v<{}, codegen_error>, ",
-		constexpr_err_type
-	);
+	ctx.writef("static_assert({}, ", constexpr_condition);
 	ctx.writef("\n\"| [Ecsact C++ Error]: {}\\n\"", err_title);
 	for(auto line : err_msg | std::views::split('\n')) {
 		ctx.writef("\n\"| {}\\n\"", std::string_view{line.begin(), line.end()});
@@ -77,11 +75,26 @@ static auto write_static_assert_codegen_error(
 	ctx.writef(");");
 }
 
-static auto write_context_method_error_body(
-	ecsact::codegen_plugin_context&           ctx,
+static auto write_static_assert_codegen_error(
+	ecsact::codegen_plugin_context& ctx,
+	std::string_view                err_title,
+	std::string                     err_msg,
+	std::string                     constexpr_err_type = "T"
+) -> void {
+	ctx.writef("// local type to make static assert always fail\n");
+	ctx.writef("struct codegen_error {{}};\n");
+	write_static_assert_codegen_check(
+		ctx,
+		std::format("std::is_same_v<{}, codegen_error>", constexpr_err_type),
+		err_title,
+		err_msg
+	);
+}
+
+static auto allowed_components_err_msg(
 	std::string_view                          err_msg,
 	const std::set<ecsact_component_like_id>& allowed_components
-) -> void {
+) -> std::string {
 	auto full_err_msg = std::string(err_msg);
 	full_err_msg += " The following components are allowed:\n";
 
@@ -89,10 +102,44 @@ static auto write_context_method_error_body(
 		full_err_msg += "\t- " + ecsact::meta::decl_full_name(comp_like_id) + "\n";
 	}
 
+	return full_err_msg;
+}
+
+static auto write_context_method_error_body(
+	ecsact::codegen_plugin_context&           ctx,
+	std::string_view                          err_msg,
+	const std::set<ecsact_component_like_id>& allowed_components
+) -> void {
 	write_static_assert_codegen_error(
 		ctx,
 		"System Execution Context Misuse",
-		full_err_msg
+		allowed_components_err_msg(err_msg, allowed_components)
+	);
+}
+
+/**
+ * Same as `write_context_method_error_body`, but for variadic methods where
+ * every type in the `T...` pack must be one of the allowed components.
+ */
+static auto write_context_variadic_method_check(
+	ecsact::codegen_plugin_context&           ctx,
+	std::string_view                          err_msg,
+	const std::set<ecsact_component_like_id>& allowed_components
+) -> void {
+	auto allowed_types_str = comma_delim(
+		allowed_components | std::views::transform([](auto comp_like_id) {
+			return cpp_identifier(ecsact::meta::decl_full_name(comp_like_id));
+		})
+	);
+
+	write_static_assert_codegen_check(
+		ctx,
+		std::format(
+			"(::ecsact::detail::one_of<T, {}> && ...)",
+			allowed_types_str
+		),
+		"System Execution Context Misuse",
+		allowed_components_err_msg(err_msg, allowed_components)
 	);
 }
 
@@ -116,6 +163,52 @@ static auto write_context_get_decl(
 	ctx.writef("\n\n");
 }
 
+static auto write_context_assoc_decl(
+	ecsact::codegen_plugin_context&           ctx,
+	std::string_view                          sys_like_full_name,
+	const std::set<ecsact_component_like_id>& assoc_components
+) -> void {
+	ctx.writef("template<typename T, typename... AssocFields>\n");
+	block(ctx, "auto assoc(AssocFields&&... assoc_fields)", [&] {
+		write_context_method_error_body(
+			ctx,
+			std::format(
+				"{} context.assoc<T> may only be called with a component with assoc "
+				"fields readable by the system.",
+				sys_like_full_name
+			),
+			assoc_components
+		);
+	});
+	ctx.writef("\n\n");
+}
+
+static auto write_context_view_decl(
+	ecsact::codegen_plugin_context&           ctx,
+	std::string_view                          sys_like_full_name,
+	const std::set<ecsact_component_like_id>& viewable_components
+) -> void {
+	ctx.writef("template<typename T, typename... AssocFields>\n");
+	block(
+		ctx,
+		"auto view(AssocFields&&... assoc_fields) -> "
+		"::ecsact::component_view_t<T>",
+		[&] {
+			write_context_method_error_body(
+				ctx,
+				std::format(
+					"{} context.view<T> may only be called with a component the system "
+					"has readonly capabilities for. Use context.get<T> for readwrite "
+					"components.",
+					sys_like_full_name
+				),
+				viewable_components
+			);
+		}
+	);
+	ctx.writef("\n\n");
+}
+
 static auto write_context_update_decl(
 	ecsact::codegen_plugin_context&           ctx,
 	std::string_view                          sys_like_full_name,
@@ -142,6 +235,35 @@ static auto write_context_update_decl(
 	ctx.writef("\n\n");
 }
 
+static auto write_context_modify_decl(
+	ecsact::codegen_plugin_context&           ctx,
+	std::string_view                          sys_like_full_name,
+	std::string_view                          ctx_type_name,
+	const std::set<ecsact_component_like_id>& modifiable_components
+) -> void {
+	ctx.writef("template<typename T>\n");
+	block(
+		ctx,
+		std::format(
+			"auto modify() -> ::ecsact::component_modifier<T, {}>",
+			ctx_type_name
+		),
+		[&] {
+			write_context_method_error_body(
+				ctx,
+				std::format(
+					"{} context.modify<T> may only be called with a component readable "
+					"and writable by the system that has no assoc fields. Did you forget "
+					"to add readwrite capabilities?",
+					sys_like_full_name
+				),
+				modifiable_components
+			);
+		}
+	);
+	ctx.writef("\n\n");
+}
+
 static auto write_context_add_decl(
 	ecsact::codegen_plugin_context&           ctx,
 	std::string_view                          sys_like_full_name,
@@ -244,6 +366,61 @@ static auto write_context_stream_toggle_decl(
 	ctx.write("\n\n");
 }
 
+static auto write_context_get_many_decl(
+	ecsact::codegen_plugin_context&           ctx,
+	std::string_view                          sys_like_full_name,
+	const std::set<ecsact_component_like_id>& gettable_components
+) -> void {
+	ctx.writef("template<typename... T>\n");
+	block(ctx, "auto get_many() -> std::tuple<T...>", [&] {
+		write_context_variadic_method_check(
+			ctx,
+			std::format(
+				"{} context.get_many<T...> may only be called with components "
+				"readable by the system that have no assoc fields. Did you forget to "
+				"add readonly or readwrite capabilities?",
+				sys_like_full_name
+			),
+			gettable_components
+		);
+		ctx.writef("\n#ifdef ECSACT_CPP_CONTEXT_READ_CACHE\n");
+		ctx.writef("return std::tuple<T...>{{this->template get<T>()...}};\n");
+		ctx.writef("#else\n");
+		ctx.writef("return _ctx.get_many<T...>();\n");
+		ctx.writef("#endif");
+	});
+	ctx.writef("\n\n");
+}
+
+static auto write_context_update_many_decl(
+	ecsact::codegen_plugin_context&           ctx,
+	std::string_view                          sys_like_full_name,
+	const std::set<ecsact_component_like_id>& updatable_components
+) -> void {
+	ctx.writef("template<typename... T>\n");
+	block(
+		ctx,
+		"auto update_many(const T&... updated_components) -> void",
+		[&] {
+			write_context_variadic_method_check(
+				ctx,
+				std::format(
+					"{} context.update_many<T...> may only be called with components "
+					"writable by the system that have no assoc fields. Did you forget "
+					"to add readwrite capabilities?",
+					sys_like_full_name
+				),
+				updatable_components
+			);
+			ctx.writef("\n_ctx.update_many(updated_components...);\n");
+			ctx.writef("#ifdef ECSACT_CPP_CONTEXT_READ_CACHE\n");
+			ctx.writef("(_read_cache_store(updated_components), ...);\n");
+			ctx.writef("#endif");
+		}
+	);
+	ctx.writef("\n\n");
+}
+
 static auto write_context_other_decl(
 	ecsact::codegen_plugin_context&     ctx,
 	std::vector<ecsact_system_assoc_id> assoc_ids
@@ -277,6 +454,113 @@ static auto write_context_other_decl(
 	ctx.writef("\n");
 }
 
+/**
+ * Writes a structural change that is recorded into the context command buffer
+ * when ECSACT_CPP_COMMAND_BUFFER is defined and a buffer was given to the
+ * context. Otherwise @p direct_code calls the runtime immediately.
+ */
+static auto write_deferrable_command(
+	ecsact::codegen_plugin_context& ctx,
+	std::string_view                deferred_code,
+	std::string_view                direct_code
+) -> void {
+	ctx.writef("#ifdef ECSACT_CPP_COMMAND_BUFFER\n");
+	block(ctx, "if(_commands != nullptr)", [&] {
+		ctx.writef("{}", deferred_code);
+	});
+	block(ctx, " else", [&] { ctx.writef("{}", direct_code); });
+	ctx.writef("\n#else\n");
+	ctx.writef("{}\n", direct_code);
+	ctx.writef("#endif");
+}
+
+/**
+ * Writes `generate`, `generate_n` and `generate_batch` for systems with
+ * `generates` blocks. The components must match at least one block: every
+ * required component present and no component outside the block.
+ */
+static auto write_context_generate_decl(
+	ecsact::codegen_plugin_context&                ctx,
+	std::string_view                               sys_like_full_name,
+	ecsact_system_like_id                          sys_like_id,
+	const std::vector<ecsact_system_generates_id>& gen_ids
+) -> void {
+	if(gen_ids.empty()) {
+		return;
+	}
+
+	auto condition = std::string{};
+	auto err_msg = std::format(
+		"{} context.generate<T...> must be called with components matching one "
+		"of the system generates blocks:\n",
+		sys_like_full_name
+	);
+
+	for(auto gen_id : gen_ids) {
+		auto required = std::vector<std::string>{};
+		auto optional = std::vector<std::string>{};
+		err_msg += "\t-";
+		for(auto&& [comp_id, flag] :
+				system_generates_components(sys_like_id, gen_id)) {
+			auto comp_name = ecsact::meta::decl_full_name(comp_id);
+			if(flag == ECSACT_SYS_GEN_REQUIRED) {
+				required.emplace_back(cpp_identifier(comp_name));
+				err_msg += std::format(" required {}", comp_name);
+			} else {
+				optional.emplace_back(cpp_identifier(comp_name));
+				err_msg += std::format(" optional {}", comp_name);
+			}
+		}
+		err_msg += "\n";
+
+		if(!condition.empty()) {
+			condition += " || ";
+		}
+		condition += std::format(
+			"::ecsact::detail::generates_match_v<"
+			"::ecsact::detail::type_list<{}>, "
+			"::ecsact::detail::type_list<{}>, T...>",
+			comma_delim(required),
+			comma_delim(optional)
+		);
+	}
+
+	auto write_generate_fn = [&](
+														 std::string_view fn_name,
+														 std::string_view params,
+														 std::string_view args
+													 ) {
+		ctx.writef("template<typename... T>\n");
+		block(ctx, std::format("auto {}({}) -> void", fn_name, params), [&] {
+			write_static_assert_codegen_check(
+				ctx,
+				condition,
+				"System Execution Context Misuse",
+				err_msg
+			);
+			ctx.writef("\n");
+			write_deferrable_command(
+				ctx,
+				std::format("_commands->{}(_ctx, {});", fn_name, args),
+				std::format("_ctx.{}({});", fn_name, args)
+			);
+		});
+		ctx.writef("\n\n");
+	};
+
+	write_generate_fn("generate", "const T&... components", "components...");
+	write_generate_fn(
+		"generate_n",
+		"std::size_t count, const T&... components",
+		"count, components..."
+	);
+	write_generate_fn(
+		"generate_batch",
+		"std::span<const T>... components",
+		"components..."
+	);
+}
+
 static void write_context_action(
 	ecsact::codegen_plugin_context& ctx,
 	ecsact_action_id                act_id
@@ -284,9 +568,70 @@ static void write_context_action(
 	auto full_name = ecsact::meta::decl_full_name(act_id);
 	auto cpp_full_name = cpp_identifier(full_name);
 
-	block(ctx, std::format("auto action() const -> {}", cpp_full_name), [&] {
-		ctx.writef("return _ctx.action<{}>();", cpp_full_name);
-	});
+	ctx.writef("mutable std::optional<{}> _action;\n\n", cpp_full_name);
+	block(
+		ctx,
+		std::format("auto action() const -> const {}&", cpp_full_name),
+		[&] {
+			ctx.writef("#ifdef ECSACT_CPP_RUNTIME_ACTION_PTR\n");
+			block(
+				ctx,
+				std::format("if(auto ptr = _ctx.action_ptr<{}>())", cpp_full_name),
+				[&] { ctx.writef("return *ptr;"); }
+			);
+			ctx.writef("\n#endif\n");
+			block(ctx, "if(!_action)", [&] {
+				ctx.writef("_action = _ctx.action<{}>();", cpp_full_name);
+			});
+			ctx.writef("\nreturn *_action;");
+		}
+	);
+	ctx.writef("\n");
+}
+
+/**
+ * Writes the out of line `parent()` definition for child systems. The parent
+ * context is created on first use and kept in the child context, so references
+ * into it (e.g. `parent().action()`) stay valid for the whole `impl` call.
+ */
+static auto write_context_parent_def(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_system_id                sys_id
+) -> void {
+	auto parent_id = ecsact::meta::get_parent_system_id(sys_id);
+	if(!parent_id) {
+		return;
+	}
+
+	auto full_name = ecsact::meta::decl_full_name(sys_id);
+	if(full_name.empty()) {
+		full_name += ecsact::meta::package_name(ctx.package_id) + ".";
+		full_name += anonymous_system_name(sys_id);
+	}
+	auto parent_full_name = ecsact::meta::decl_full_name(*parent_id);
+	if(parent_full_name.empty()) {
+		parent_full_name += ecsact::meta::package_name(ctx.package_id) + ".";
+		parent_full_name += anonymous_system_name(*parent_id);
+	}
+
+	ctx.writef("\n");
+	block(
+		ctx,
+		std::format(
+			"inline auto {}::context::parent() const -> const {}::context&",
+			cpp_identifier(full_name),
+			cpp_identifier(parent_full_name)
+		),
+		[&] {
+			block(ctx, "if(!_parent)", [&] {
+				ctx.writef(
+					"_parent.emplace({}::context{{._ctx = _ctx.parent()}});",
+					cpp_identifier(parent_full_name)
+				);
+			});
+			ctx.writef("\nreturn *_parent;");
+		}
+	);
 	ctx.writef("\n");
 }
 
@@ -320,6 +665,18 @@ static auto assoc_field_ids( //
 	return result;
 }
 
+static auto without_assoc_fields( //
+	const std::set<ecsact_component_like_id>& components
+) -> std::set<ecsact_component_like_id> {
+	auto result = std::set<ecsact_component_like_id>{};
+	for(auto comp_id : components) {
+		if(assoc_field_ids(comp_id).empty()) {
+			result.emplace(comp_id);
+		}
+	}
+	return result;
+}
+
 template<typename CompositeID>
 static auto assoc_field_names_only_str(CompositeID compo_id) -> std::string {
 	auto result = std::string{};
@@ -370,7 +727,8 @@ static auto assoc_fields_str(CompositeID compo_id) -> std::string {
 
 static void write_context_get_specialize(
 	ecsact::codegen_plugin_context& ctx,
-	ecsact_component_like_id        comp_id
+	ecsact_component_like_id        comp_id,
+	bool                            cached
 ) {
 	using ecsact::cc_lang_support::cpp_identifier;
 
@@ -394,12 +752,102 @@ static void write_context_get_specialize(
 			assoc_fields
 		),
 		[&] {
+			if(cached) {
+				ctx.writef("#ifdef ECSACT_CPP_CONTEXT_READ_CACHE\n");
+				ctx.writef(
+					"auto& cached = std::get<std::optional<{}>>(_read_cache);\n",
+					cpp_full_name
+				);
+				block(ctx, "if(!cached)", [&] {
+					ctx.writef("cached = _ctx.get<{}>();", cpp_full_name);
+				});
+				ctx.writef("\nreturn *cached;\n");
+				ctx.writef("#else\n");
+			}
 			ctx.writef(
 				"return _ctx.get<{0}{1}>({2});",
 				cpp_full_name,
 				assoc_field_types_only,
 				assoc_field_names_only
 			);
+			if(cached) {
+				ctx.writef("\n#endif");
+			}
+		}
+	);
+
+	ctx.writef("\n");
+}
+
+/**
+ * Writes `assoc<C>(fields...)` returning a `::ecsact::assoc_accessor` that is
+ * only writable when the system may update @p comp_id.
+ */
+static auto write_context_assoc_specialize(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_component_like_id        comp_id,
+	bool                            writable
+) -> void {
+	auto cpp_full_name = cpp_identifier(ecsact::meta::decl_full_name(comp_id));
+	auto assoc_fields = assoc_fields_str(comp_id);
+	auto assoc_field_types_only = assoc_field_types_only_str(comp_id);
+	auto assoc_field_names = std::vector<std::string>{};
+	for(auto field_id : assoc_field_ids(comp_id)) {
+		assoc_field_names.emplace_back(ecsact::meta::field_name(comp_id, field_id));
+	}
+
+	block(
+		ctx,
+		std::format(
+			"template<> auto assoc<{}, {}>({})",
+			cpp_full_name,
+			assoc_field_types_only,
+			assoc_fields
+		),
+		[&] {
+			ctx.writef(
+				"return ::ecsact::assoc_accessor<{}, {}, {}>{{_ctx._ctx, {}}};",
+				cpp_full_name,
+				writable ? "true" : "false",
+				assoc_field_types_only,
+				comma_delim(assoc_field_names)
+			);
+		}
+	);
+
+	ctx.writef("\n");
+}
+
+static void write_context_view_specialize(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_component_like_id        comp_id
+) {
+	auto decl_id = ecsact_id_cast<ecsact_decl_id>(comp_id);
+	auto full_name = ecsact_meta_decl_full_name(decl_id);
+	auto cpp_full_name = cpp_identifier(full_name);
+	auto assoc_fields = assoc_fields_str(comp_id);
+	auto assoc_field_types_only = assoc_field_types_only_str(comp_id);
+	auto assoc_field_names_only = assoc_field_names_only_str(comp_id);
+
+	if(!assoc_field_types_only.empty()) {
+		assoc_field_types_only = ", " + assoc_field_types_only;
+	}
+
+	block(
+		ctx,
+		std::format(
+			"template<> auto view<{0}{1}>({2}) -> ::ecsact::component_view_t<{0}>",
+			cpp_full_name,
+			assoc_field_types_only,
+			assoc_fields
+		),
+		[&] {
+			ctx.writef(
+				"return _ctx.view<{0}{1}>({2});",
+				cpp_full_name,
+				assoc_field_types_only,
+				assoc_field_names_only
+			);
 		}
 	);
 
@@ -423,13 +871,28 @@ static void write_context_add_specialize(
 				"template<> auto add<{0}>(const {0}& new_component) -> void",
 				cpp_full_name
 			),
-			[&] { ctx.writef("_ctx.add<{}>(new_component);", cpp_full_name); }
+			[&] {
+				write_deferrable_command(
+					ctx,
+					"_commands->add(_ctx, new_component);",
+					std::format("_ctx.add<{}>(new_component);", cpp_full_name)
+				);
+				ctx.writef("\n#ifdef ECSACT_CPP_CONTEXT_READ_CACHE\n");
+				ctx.writef("_read_cache_store(new_component);\n");
+				ctx.writef("#endif");
+			}
 		);
 	} else {
 		block(
 			ctx,
 			std::format("template<> auto add<{}>() -> void", cpp_full_name),
-			[&] { ctx.writef("_ctx.add<{}>();", cpp_full_name); }
+			[&] {
+				write_deferrable_command(
+					ctx,
+					std::format("_commands->add<{}>(_ctx);", cpp_full_name),
+					std::format("_ctx.add<{}>();", cpp_full_name)
+				);
+			}
 		);
 	}
 
@@ -474,11 +937,42 @@ static auto write_context_update_specialize(
 				cpp_full_name,
 				assoc_field_names_only
 			);
+			if(assoc_field_names_only.empty()) {
+				ctx.writef("\n#ifdef ECSACT_CPP_CONTEXT_READ_CACHE\n");
+				ctx.writef("_read_cache_store(updated_component);\n");
+				ctx.writef("#endif");
+			}
 		}
 	);
 	ctx.writef("\n");
 }
 
+static auto write_context_modify_specialize(
+	ecsact::codegen_plugin_context& ctx,
+	std::string_view                ctx_type_name,
+	ecsact_component_like_id        comp_id
+) -> void {
+	auto decl_id = ecsact_id_cast<ecsact_decl_id>(comp_id);
+	auto full_name = ecsact_meta_decl_full_name(decl_id);
+	auto cpp_full_name = cpp_identifier(full_name);
+	auto modifier_type_name = std::format(
+		"::ecsact::component_modifier<{}, {}>",
+		cpp_full_name,
+		ctx_type_name
+	);
+
+	block(
+		ctx,
+		std::format(
+			"template<> auto modify<{}>() -> {}",
+			cpp_full_name,
+			modifier_type_name
+		),
+		[&] { ctx.writef("return {}{{*this}};", modifier_type_name); }
+	);
+	ctx.writef("\n");
+}
+
 static auto write_context_remove_specialize(
 	ecsact::codegen_plugin_context& ctx,
 	ecsact_component_like_id        comp_id
@@ -490,7 +984,16 @@ static auto write_context_remove_specialize(
 	block(
 		ctx,
 		std::format("template<> auto remove<{}>() -> void", cpp_full_name),
-		[&] { ctx.writef("return _ctx.remove<{}>();\n", cpp_full_name); }
+		[&] {
+			write_deferrable_command(
+				ctx,
+				std::format("_commands->remove<{}>(_ctx);", cpp_full_name),
+				std::format("_ctx.remove<{}>();", cpp_full_name)
+			);
+			ctx.writef("\n#ifdef ECSACT_CPP_CONTEXT_READ_CACHE\n");
+			ctx.writef("_read_cache_reset<{}>();\n", cpp_full_name);
+			ctx.writef("#endif");
+		}
 	);
 
 	ctx.writef("\n");
@@ -539,10 +1042,20 @@ static auto write_context_other_specialize(
 		),
 		[&] {
 			block(ctx, std::format("return other_context<{}>", assoc_index), [&] {
+				ctx.writef("#ifdef ECSACT_CPP_CONSTEXPR_ASSOC_IDS\n");
+				ctx.writef(
+					"._ctx = _ctx.other(static_cast<ecsact_system_assoc_id>({})),\n",
+					static_cast<int32_t>(assoc_id)
+				);
+				ctx.writef("#else\n");
 				ctx.writef( //
-					"._ctx = _ctx.other({}),",
+					"._ctx = _ctx.other({}),\n",
 					c_impl_assoc_id_name
 				);
+				ctx.writef("#endif\n");
+				ctx.writef("#ifdef ECSACT_CPP_COMMAND_BUFFER\n");
+				ctx.writef("._commands = _commands,\n");
+				ctx.writef("#endif");
 			});
 			ctx.writef(";");
 		}
@@ -552,6 +1065,7 @@ static auto write_context_other_specialize(
 struct context_body_details {
 	std::set<ecsact_component_like_id> add_components;
 	std::set<ecsact_component_like_id> get_components;
+	std::set<ecsact_component_like_id> view_components;
 	std::set<ecsact_component_like_id> update_components;
 	std::set<ecsact_component_like_id> remove_components;
 	std::set<ecsact_component_like_id> optional_components;
@@ -565,6 +1079,10 @@ struct context_body_details {
 				details.get_components.emplace(comp_id);
 			}
 
+			if((cap & ECSACT_SYS_CAP_READWRITE) == ECSACT_SYS_CAP_READONLY) {
+				details.view_components.emplace(comp_id);
+			}
+
 			if((cap & ECSACT_SYS_CAP_WRITEONLY) == ECSACT_SYS_CAP_WRITEONLY) {
 				details.update_components.emplace(comp_id);
 			}
@@ -607,6 +1125,65 @@ struct context_body_details {
 	}
 };
 
+/**
+ * Writes the per-execution read cache (ECSACT_CPP_CONTEXT_READ_CACHE). The
+ * first `get<C>()` of a cached component stores the value in the context and
+ * later gets return it without calling into the runtime. `update`, `add` and
+ * `remove` keep the cache in sync. Only components without assoc fields are
+ * cached.
+ */
+static auto write_context_read_cache(
+	ecsact::codegen_plugin_context&           ctx,
+	const std::set<ecsact_component_like_id>& cached_components
+) -> void {
+	auto cached_types = std::vector<std::string>{};
+	for(auto comp_id : cached_components) {
+		cached_types.emplace_back(
+			cpp_identifier(ecsact::meta::decl_full_name(comp_id))
+		);
+	}
+
+	auto optional_types = comma_delim(
+		cached_types |
+		std::views::transform([](auto t) { return "std::optional<" + t + ">"; })
+	);
+
+	ctx.writef("#ifdef ECSACT_CPP_CONTEXT_READ_CACHE\n");
+	ctx.writef("std::tuple<{}> _read_cache{{}};\n\n", optional_types);
+
+	ctx.writef("template<typename T>\n");
+	block(ctx, "auto _read_cache_store(const T& value) -> void", [&] {
+		if(cached_types.empty()) {
+			return;
+		}
+		block(
+			ctx,
+			std::format(
+				"if constexpr(::ecsact::detail::one_of<T, {}>)",
+				comma_delim(cached_types)
+			),
+			[&] { ctx.writef("std::get<std::optional<T>>(_read_cache) = value;"); }
+		);
+	});
+	ctx.writef("\n\n");
+
+	ctx.writef("template<typename T>\n");
+	block(ctx, "auto _read_cache_reset() -> void", [&] {
+		if(cached_types.empty()) {
+			return;
+		}
+		block(
+			ctx,
+			std::format(
+				"if constexpr(::ecsact::detail::one_of<T, {}>)",
+				comma_delim(cached_types)
+			),
+			[&] { ctx.writef("std::get<std::optional<T>>(_read_cache).reset();"); }
+		);
+	});
+	ctx.writef("\n#endif\n\n");
+}
+
 /**
  * Write execution context body methods that are common between systems,
  * actions, and other (entity association) contexts.
@@ -614,13 +1191,32 @@ struct context_body_details {
 static auto write_context_body_common(
 	ecsact::codegen_plugin_context& ctx,
 	std::string                     ctx_name,
+	std::string                     ctx_type_name,
 	context_body_details            details
 ) -> void {
 	ctx.writef("[[no_unique_address]] ::ecsact::execution_context _ctx;\n\n");
+	ctx.writef("#ifdef ECSACT_CPP_COMMAND_BUFFER\n");
+	ctx.writef("::ecsact::command_buffer* _commands = nullptr;\n");
+	ctx.writef("#endif\n\n");
+
+	auto get_many_components = without_assoc_fields(details.get_components);
+	write_context_read_cache(ctx, get_many_components);
 
 	if(!details.get_components.empty()) {
 		write_context_get_decl(ctx, ctx_name, details.get_components);
 	}
+	auto assoc_components = std::set<ecsact_component_like_id>{};
+	std::ranges::set_difference(
+		details.get_components,
+		get_many_components,
+		std::inserter(assoc_components, assoc_components.end())
+	);
+	if(!assoc_components.empty()) {
+		write_context_assoc_decl(ctx, ctx_name, assoc_components);
+	}
+	if(!details.view_components.empty()) {
+		write_context_view_decl(ctx, ctx_name, details.view_components);
+	}
 	if(!details.update_components.empty()) {
 		write_context_update_decl(ctx, ctx_name, details.update_components);
 	}
@@ -638,8 +1234,43 @@ static auto write_context_body_common(
 		write_context_stream_toggle_decl(ctx, ctx_name, details.stream_components);
 	}
 
+	if(!get_many_components.empty()) {
+		write_context_get_many_decl(ctx, ctx_name, get_many_components);
+	}
+
+	auto update_many_components = without_assoc_fields(details.update_components);
+	if(!update_many_components.empty()) {
+		write_context_update_many_decl(ctx, ctx_name, update_many_components);
+	}
+
+	auto modify_components = std::set<ecsact_component_like_id>{};
+	std::ranges::set_intersection(
+		get_many_components,
+		update_many_components,
+		std::inserter(modify_components, modify_components.end())
+	);
+	if(!modify_components.empty()) {
+		write_context_modify_decl(ctx, ctx_name, ctx_type_name, modify_components);
+	}
+
 	for(auto get_comp_id : details.get_components) {
-		write_context_get_specialize(ctx, get_comp_id);
+		write_context_get_specialize(
+			ctx,
+			get_comp_id,
+			get_many_components.contains(get_comp_id)
+		);
+	}
+
+	for(auto assoc_comp_id : assoc_components) {
+		write_context_assoc_specialize(
+			ctx,
+			assoc_comp_id,
+			details.update_components.contains(assoc_comp_id)
+		);
+	}
+
+	for(auto view_comp_id : details.view_components) {
+		write_context_view_specialize(ctx, view_comp_id);
 	}
 
 	for(auto add_comp_id : details.add_components) {
@@ -650,6 +1281,10 @@ static auto write_context_body_common(
 		write_context_update_specialize(ctx, update_comp_id);
 	}
 
+	for(auto modify_comp_id : modify_components) {
+		write_context_modify_specialize(ctx, ctx_type_name, modify_comp_id);
+	}
+
 	for(auto remove_comp_id : details.remove_components) {
 		write_context_remove_specialize(ctx, remove_comp_id);
 	}
@@ -696,6 +1331,7 @@ static auto write_sys_context(
 				write_context_body_common(
 					ctx,
 					std::format("{} (assoc {})", full_name, i),
+					std::format("other_context<{}>", i),
 					context_body_details::from_assoc_id(sys_like_id, assoc_ids[i])
 				);
 			});
@@ -710,10 +1346,12 @@ static auto write_sys_context(
 		write_context_body_common(
 			ctx,
 			full_name,
+			"context",
 			context_body_details::from_sys_like(sys_like_id)
 		);
 
 		auto gen_ids = get_system_generates_ids(sys_like_id);
+		write_context_generate_decl(ctx, full_name, sys_like_id, gen_ids);
 
 		write_context_other_decl(ctx, assoc_ids);
 
@@ -724,7 +1362,14 @@ static auto write_sys_context(
 				parent_full_name += anonymous_system_name(*parent_sys_like_id);
 			}
 			auto parent_cpp_full_name = cpp_identifier(parent_full_name);
-			ctx.writef("const {}::context parent() const;\n", parent_cpp_full_name);
+			ctx.writef(
+				"mutable std::optional<{}::context> _parent;\n\n",
+				parent_cpp_full_name
+			);
+			ctx.writef(
+				"auto parent() const -> const {}::context&;\n",
+				parent_cpp_full_name
+			);
 		}
 
 		ctx.writef("\n\n");
@@ -738,6 +1383,170 @@ static auto write_sys_context(
 	ctx.writef(";\n");
 };
 
+/**
+ * Writes the contexts of every descendant of @p parent_id, each after its
+ * parent, since child contexts hold their parent context by value.
+ */
+static auto write_child_sys_contexts(
+	ecsact::codegen_plugin_context& ctx,
+	auto                            parent_id
+) -> void {
+	auto parent_sys_like_id = ecsact_id_cast<ecsact_system_like_id>(parent_id);
+	for(auto child_id : ecsact::meta::get_child_system_ids(parent_sys_like_id)) {
+		write_sys_context(ctx, child_id, [] {});
+		write_child_sys_contexts(ctx, child_id);
+	}
+}
+
+/**
+ * Writes `<package>::declared_capabilities` used by
+ * `ecsact::access_counters::unused_capabilities` when
+ * ECSACT_CPP_EXECUTION_CONTEXT_COUNTERS is defined. Capabilities of a system's
+ * assoc components are merged into the system's own since accesses through
+ * `other<N>()` are counted for the same system.
+ */
+static auto write_declared_capabilities(ecsact::codegen_plugin_context& ctx)
+	-> void {
+	auto entries = std::vector<std::string>{};
+
+	auto add_entries = [&](ecsact_system_like_id sys_like_id) {
+		std::string full_name = ecsact::meta::decl_full_name(sys_like_id);
+		if(full_name.empty()) {
+			full_name += ecsact::meta::package_name(ctx.package_id) + ".";
+			full_name += anonymous_system_name(sys_like_id);
+		}
+
+		auto caps = std::map<ecsact_component_like_id, int>{};
+		auto sys_caps = ecsact::meta::system_capabilities(sys_like_id);
+		for(auto&& [comp_id, cap] : sys_caps) {
+			caps[comp_id] |= cap;
+		}
+		for(auto assoc_id : ecsact::meta::system_assoc_ids(sys_like_id)) {
+			auto assoc_caps =
+				ecsact::meta::system_assoc_capabilities(sys_like_id, assoc_id);
+			for(auto&& [comp_id, cap] : assoc_caps) {
+				caps[comp_id] |= cap;
+			}
+		}
+
+		for(auto&& [comp_id, cap] : caps) {
+			entries.emplace_back(std::format(
+				"\t{{\n"
+				"\t\tecsact_id_cast<ecsact_system_like_id>({}::id),\n"
+				"\t\tecsact_id_cast<ecsact_component_like_id>({}::id),\n"
+				"\t\tstatic_cast<ecsact_system_capability>({}),\n"
+				"\t}},\n",
+				cpp_identifier(full_name),
+				cpp_identifier(ecsact::meta::decl_full_name(comp_id)),
+				cap
+			));
+		}
+	};
+
+	for(auto sys_id : get_system_ids(ctx.package_id)) {
+		add_entries(ecsact_id_cast<ecsact_system_like_id>(sys_id));
+	}
+	for(auto act_id : get_action_ids(ctx.package_id)) {
+		add_entries(ecsact_id_cast<ecsact_system_like_id>(act_id));
+	}
+
+	if(entries.empty()) {
+		return;
+	}
+
+	auto package_ns = cpp_identifier(ecsact::meta::package_name(ctx.package_id));
+
+	ctx.writef("\n#ifdef ECSACT_CPP_EXECUTION_CONTEXT_COUNTERS\n");
+	ctx.writef("namespace {} {{\n", package_ns);
+	ctx.writef(
+		"inline constexpr ::ecsact::access_counters::declared_capability\n"
+		"\tdeclared_capabilities[] = {{\n"
+	);
+	for(auto& entry : entries) {
+		ctx.writef("{}", entry);
+	}
+	ctx.writef("}};\n");
+	ctx.writef("}} // namespace {}\n", package_ns);
+	ctx.writef("#endif\n");
+}
+
+static auto write_sys_soa_batch_context(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_system_id                sys_id
+) -> void {
+	auto columns = soa_batch_columns(sys_id);
+	if(columns.empty()) {
+		return;
+	}
+
+	auto full_name = ecsact::meta::decl_full_name(sys_id);
+	auto column_components = std::set<ecsact_component_like_id>{};
+	for(auto&& [comp_id, _] : columns) {
+		column_components.emplace(comp_id);
+	}
+
+	ctx.writef("\n#ifdef ECSACT_CPP_SOA_BATCH\n");
+	auto head =
+		std::format("struct {}::batch_context", cpp_identifier(full_name));
+	block(ctx, head, [&] {
+		ctx.writef("int32_t                   _count;\n");
+		ctx.writef("const ::ecsact_entity_id* _entities;\n");
+		ctx.writef("void* const*              _columns;\n\n");
+
+		block(ctx, "auto size() const -> std::size_t", [&] {
+			ctx.writef("return static_cast<std::size_t>(_count);");
+		});
+		ctx.writef("\n\n");
+
+		block(
+			ctx,
+			"auto entities() const -> std::span<const ::ecsact_entity_id>",
+			[&] { ctx.writef("return {{_entities, size()}};"); }
+		);
+		ctx.writef("\n\n");
+
+		ctx.writef("template<typename T>\n");
+		block(ctx, "auto column()", [&] {
+			write_context_method_error_body(
+				ctx,
+				std::format(
+					"{} batch_context.column<T> may only be called with a component "
+					"readable or writable by the system.",
+					full_name
+				),
+				column_components
+			);
+		});
+		ctx.writef("\n\n");
+
+		for(auto i = 0; columns.size() > i; ++i) {
+			auto&& [comp_id, cap] = columns[i];
+			auto comp_name = ecsact::meta::decl_full_name(comp_id);
+			auto cpp_comp_name = cpp_identifier(comp_name);
+			auto writable =
+				(cap & ECSACT_SYS_CAP_WRITEONLY) == ECSACT_SYS_CAP_WRITEONLY;
+			auto element_type_name =
+				writable ? cpp_comp_name : std::format("const {}", cpp_comp_name);
+
+			block(
+				ctx,
+				std::format("template<> auto column<{}>()", cpp_comp_name),
+				[&] {
+					ctx.writef(
+						"return std::span<{0}>"
+						"{{static_cast<{0}*>(_columns[{1}]), size()}};",
+						element_type_name,
+						i
+					);
+				}
+			);
+			ctx.writef("\n");
+		}
+	});
+	ctx.writef(";\n");
+	ctx.writef("#endif\n");
+}
+
 void ecsact_codegen_plugin(
 	ecsact_package_id          package_id,
 	ecsact_codegen_write_fn_t  write_fn,
@@ -757,7 +1566,17 @@ void ecsact_codegen_plugin(
 		package_systems_h_path.extension().string() + ".systems.h"
 	);
 
+	ctx.writef("#include <optional>\n");
 	ctx.writef("#include <type_traits>\n");
+	ctx.writef("#ifdef ECSACT_CPP_SOA_BATCH\n");
+	ctx.writef("#	include <span>\n");
+	ctx.writef("#endif\n");
+	ctx.writef("#ifdef ECSACT_CPP_COMMAND_BUFFER\n");
+	ctx.writef("#	include \"ecsact/cpp/command_buffer.hh\"\n");
+	ctx.writef("#endif\n");
+	ctx.writef("#ifdef ECSACT_CPP_CONTEXT_READ_CACHE\n");
+	ctx.writef("#	include <tuple>\n");
+	ctx.writef("#endif\n");
 	ctx.writef("#include \"ecsact/cpp/execution_context.hh\"\n");
 	ctx.writef("#include \"{}\"\n", package_hh_path.filename().string());
 	ctx.writef("#include \"{}\"\n", package_systems_h_path.filename().string());
@@ -784,10 +1603,24 @@ void ecsact_codegen_plugin(
 	ctx.writef("\nstruct ecsact_system_execution_context;\n");
 
 	for(auto sys_id : get_system_ids(ctx.package_id)) {
+		if(ecsact::meta::get_parent_system_id(sys_id)) {
+			continue;
+		}
 		write_sys_context(ctx, sys_id, [] {});
+		write_child_sys_contexts(ctx, sys_id);
 	}
 
 	for(auto act_id : get_action_ids(ctx.package_id)) {
 		write_sys_context(ctx, act_id, [&] { write_context_action(ctx, act_id); });
+		write_child_sys_contexts(ctx, act_id);
+	}
+
+	for(auto sys_id : get_system_ids(ctx.package_id)) {
+		write_context_parent_def(ctx, sys_id);
+	}
+
+	for(auto sys_id : get_system_ids(ctx.package_id)) {
+		write_sys_soa_batch_context(ctx, sys_id);
 	}
+	write_declared_capabilities(ctx);
 }
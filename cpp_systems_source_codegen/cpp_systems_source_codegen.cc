@@ -1,15 +1,161 @@
 #include <string>
+#include <format>
 #include <filesystem>
 #include "ecsact/runtime/meta.hh"
 #include "ecsact/codegen/plugin.h"
 #include "ecsact/codegen/plugin.hh"
 #include "ecsact/lang-support/lang-cc.hh"
+#include "ecsact/cpp_codegen_plugin_util.hh"
 
 namespace fs = std::filesystem;
 
 constexpr auto GENERATED_FILE_DISCLAIMER = R"(// GENERATED FILE - DO NOT EDIT
 )";
 
+static void write_dispatch_init(ecsact::codegen_plugin_context& ctx) {
+	ctx.writef("#ifdef ECSACT_CPP_EXECUTION_CONTEXT_DISPATCH\n");
+	ctx.writef("\t::ecsact::ensure_execution_context_dispatch();\n");
+	ctx.writef("#endif\n");
+}
+
+static void write_profiling_scope(
+	ecsact::codegen_plugin_context& ctx,
+	std::string_view                cpp_full_name,
+	std::string_view                entity_count
+) {
+	ctx.writef("#ifdef ECSACT_CPP_SYSTEM_PROFILING\n");
+	ctx.writef(
+		"\tauto profiling_scope = ::ecsact::profiling::scope{{\n"
+		"\t\tecsact_id_cast<ecsact_system_like_id>({}::id),\n"
+		"\t\t{},\n"
+		"\t}};\n",
+		cpp_full_name,
+		entity_count
+	);
+	ctx.writef("#endif\n");
+}
+
+static void write_trace_span(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_system_like_id           sys_like_id,
+	std::string_view                entity_count
+) {
+	auto parent_name = std::string{"nullptr"};
+	auto parent_id = ecsact::meta::get_parent_system_id(sys_like_id);
+	if(parent_id) {
+		parent_name =
+			std::format("\"{}\"", ecsact::meta::decl_full_name(*parent_id));
+	}
+
+	ctx.writef("#ifdef ECSACT_CPP_SYSTEM_TRACE\n");
+	ctx.writef(
+		"\tauto trace_span = ::ecsact::trace::span{{\"{}\", {}, {}}};\n",
+		ecsact::meta::decl_full_name(sys_like_id),
+		parent_name,
+		entity_count
+	);
+	ctx.writef("#endif\n");
+}
+
+/**
+ * Opens an `ecsact::access_counters::system_scope` so accesses are counted for
+ * the system without asking the runtime for its id.
+ */
+static void write_access_counters_scope(
+	ecsact::codegen_plugin_context& ctx,
+	std::string_view                cpp_full_name
+) {
+	ctx.writef("#ifdef ECSACT_CPP_EXECUTION_CONTEXT_COUNTERS\n");
+	ctx.writef(
+		"\tauto access_counters_scope = ::ecsact::access_counters::system_scope{{\n"
+		"\t\tecsact_id_cast<ecsact_system_like_id>({}::id),\n"
+		"\t}};\n",
+		cpp_full_name
+	);
+	ctx.writef("#endif\n");
+}
+
+/**
+ * Opens an `ecsact::redundant_access::scope` covering one `impl` call.
+ */
+static void write_redundant_access_scope(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_system_like_id           sys_like_id,
+	std::string_view                indent
+) {
+	auto full_name = ecsact::meta::decl_full_name(sys_like_id);
+
+	ctx.writef("#ifdef ECSACT_CPP_REDUNDANT_ACCESS_CHECK\n");
+	ctx.writef(
+		"{0}auto redundant_access_scope = ::ecsact::redundant_access::scope{{\n"
+		"{0}\tecsact_id_cast<ecsact_system_like_id>({1}::id),\n"
+		"{0}\t\"{2}\",\n"
+		"{0}}};\n",
+		indent,
+		ecsact::cc_lang_support::cpp_identifier(full_name),
+		full_name
+	);
+	ctx.writef("#endif\n");
+}
+
+static void write_system_soa_batch_fn(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_system_id                sys_id
+) {
+	using ecsact::cc_lang_support::c_identifier;
+	using ecsact::cc_lang_support::cpp_identifier;
+	using ecsact::cpp_codegen_plugin_util::soa_batch_columns;
+
+	auto columns = soa_batch_columns(sys_id);
+	if(columns.empty()) {
+		return;
+	}
+
+	auto full_name = ecsact::meta::decl_full_name(sys_id);
+	auto c_impl_fn_name = c_identifier(full_name);
+	auto cpp_full_name = cpp_identifier(full_name);
+
+	ctx.writef(
+		"\n#if defined(ECSACT_CPP_SOA_BATCH) && "
+		"defined(ECSACT_CPP_SOA_BATCH_{})\n",
+		c_impl_fn_name
+	);
+	ctx.writef(
+		"const ecsact_component_like_id {}__soa_columns[{}] = {{\n",
+		c_impl_fn_name,
+		columns.size()
+	);
+	for(auto&& [comp_id, _] : columns) {
+		ctx.writef(
+			"\tecsact_id_cast<ecsact_component_like_id>({}::id),\n",
+			cpp_identifier(ecsact::meta::decl_full_name(comp_id))
+		);
+	}
+	ctx.writef("}};\n\n");
+
+	ctx.writef(
+		"void {}__soa(\n"
+		"\tint32_t                 entity_count,\n"
+		"\tconst ecsact_entity_id* entities,\n"
+		"\tvoid* const*            columns\n"
+		") {{\n",
+		c_impl_fn_name
+	);
+	write_profiling_scope(ctx, cpp_full_name, "entity_count");
+	write_trace_span(
+		ctx,
+		ecsact_id_cast<ecsact_system_like_id>(sys_id),
+		"entity_count"
+	);
+	ctx.writef(
+		"\t{}::batch_context ctx{{entity_count, entities, columns}};\n",
+		cpp_full_name
+	);
+	ctx.writef("\t{}::batch_impl(ctx);\n", cpp_full_name);
+	ctx.writef("}}\n");
+	ctx.writef("#endif\n");
+}
+
 void ecsact_codegen_plugin(
 	ecsact_package_id          package_id,
 	ecsact_codegen_write_fn_t  write_fn,
@@ -28,6 +174,12 @@ void ecsact_codegen_plugin(
 	);
 
 	ctx.writef("#include \"{}\"\n", package_systems_hh_path.filename().string());
+	ctx.writef("#ifdef ECSACT_CPP_SYSTEM_PROFILING\n");
+	ctx.writef("#	include \"ecsact/cpp/profiling.hh\"\n");
+	ctx.writef("#endif\n");
+	ctx.writef("#ifdef ECSACT_CPP_SYSTEM_TRACE\n");
+	ctx.writef("#	include \"ecsact/cpp/trace.hh\"\n");
+	ctx.writef("#endif\n");
 
 	for(auto sys_like_id : get_all_system_like_ids(ctx.package_id)) {
 		std::string full_name =
@@ -43,9 +195,63 @@ void ecsact_codegen_plugin(
 			"void {} (struct ecsact_system_execution_context* cctx) {{\n",
 			c_identifier(full_name)
 		);
+		write_dispatch_init(ctx);
+		write_profiling_scope(ctx, cpp_full_name, "1");
+		write_trace_span(ctx, sys_like_id, "1");
+		write_access_counters_scope(ctx, cpp_full_name);
+		write_redundant_access_scope(ctx, sys_like_id, "\t");
 
+		ctx.writef("#ifdef ECSACT_CPP_COMMAND_BUFFER\n");
+		ctx.writef(
+			"\tauto& commands = ::ecsact::command_buffer::this_thread();\n"
+		);
+		ctx.writef(
+			"\t{}::context ctx{{._ctx = {{cctx}}, ._commands = &commands}};\n",
+			cpp_full_name
+		);
+		ctx.writef("\t{}::impl(ctx);\n", cpp_full_name);
+		ctx.writef("\tcommands.flush();\n");
+		ctx.writef("#else\n");
 		ctx.writef("\t{}::context ctx{{cctx}};\n", cpp_full_name);
 		ctx.writef("\t{}::impl(ctx);\n", cpp_full_name);
+		ctx.writef("#endif\n");
 		ctx.writef("}}\n");
+
+		ctx.writef(
+			"void {}__batch(\n"
+			"\tstruct ecsact_system_execution_context** cctxs,\n"
+			"\tint32_t                                  count\n"
+			") {{\n",
+			c_identifier(full_name)
+		);
+		write_dispatch_init(ctx);
+		write_profiling_scope(ctx, cpp_full_name, "count");
+		write_trace_span(ctx, sys_like_id, "count");
+		write_access_counters_scope(ctx, cpp_full_name);
+		ctx.writef("#ifdef ECSACT_CPP_COMMAND_BUFFER\n");
+		ctx.writef(
+			"\tauto& commands = ::ecsact::command_buffer::this_thread();\n"
+		);
+		ctx.writef("\tfor(int32_t i = 0; count > i; ++i) {{\n");
+		write_redundant_access_scope(ctx, sys_like_id, "\t\t");
+		ctx.writef(
+			"\t\t{}::context ctx{{._ctx = {{cctxs[i]}}, ._commands = &commands}};\n",
+			cpp_full_name
+		);
+		ctx.writef("\t\t{}::impl(ctx);\n", cpp_full_name);
+		ctx.writef("\t}}\n");
+		ctx.writef("\tcommands.flush();\n");
+		ctx.writef("#else\n");
+		ctx.writef("\tfor(int32_t i = 0; count > i; ++i) {{\n");
+		write_redundant_access_scope(ctx, sys_like_id, "\t\t");
+		ctx.writef("\t\t{}::context ctx{{cctxs[i]}};\n", cpp_full_name);
+		ctx.writef("\t\t{}::impl(ctx);\n", cpp_full_name);
+		ctx.writef("\t}}\n");
+		ctx.writef("#endif\n");
+		ctx.writef("}}\n");
+	}
+
+	for(auto sys_id : ecsact::meta::get_system_ids(ctx.package_id)) {
+		write_system_soa_batch_fn(ctx, sys_id);
 	}
 }
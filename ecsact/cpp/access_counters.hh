@@ -0,0 +1,319 @@
+#pragma once
+
+#include "ecsact/runtime/common.h"
+#include "ecsact/cpp/execution_dispatch.hh"
+
+/**
+ * Counts one @p kind access (an `ecsact::access_counters::access_kind`
+ * enumerator name) of @p component_id from the system executing in @p ctx.
+ * Expands to nothing unless ECSACT_CPP_EXECUTION_CONTEXT_COUNTERS is defined.
+ */
+#ifdef ECSACT_CPP_EXECUTION_CONTEXT_COUNTERS
+#	define ECSACT_CPP_COUNT_ACCESS(ctx, component_id, kind)     \
+		::ecsact::access_counters::detail::count(                 \
+			ctx,                                                    \
+			ecsact_id_cast<ecsact_component_like_id>(component_id), \
+			::ecsact::access_counters::access_kind::kind            \
+		)
+#else
+#	define ECSACT_CPP_COUNT_ACCESS(ctx, component_id, kind)
+#endif
+
+#ifdef ECSACT_CPP_EXECUTION_CONTEXT_COUNTERS
+#	include <map>
+#	include <span>
+#	include <array>
+#	include <deque>
+#	include <mutex>
+#	include <atomic>
+#	include <memory>
+#	include <vector>
+#	include <cstdint>
+#	include <utility>
+#	include <optional>
+
+/**
+ * Per (system, component) access counters for `ecsact::execution_context`, used
+ * when ECSACT_CPP_EXECUTION_CONTEXT_COUNTERS is defined.
+ *
+ * The generated system implementation functions open a `system_scope` so the
+ * counted system id is known without asking the runtime. Every thread counts
+ * into its own fixed size table of relaxed atomics without locking.
+ * `collect()` merges the tables of all threads on demand. Combined with the
+ * capabilities the generated systems header lists in
+ * `<package>::declared_capabilities`, `unused_capabilities()` reports
+ * capabilities a system declared but never used.
+ */
+namespace ecsact::access_counters {
+
+enum class access_kind : std::uint8_t {
+	get,
+	update,
+	add,
+	remove,
+	has,
+	stream_toggle,
+};
+
+inline constexpr auto access_kind_count = std::size_t{6};
+
+/**
+ * Maximum number of (system, component) pairs counted per thread. Accesses of
+ * further pairs are not counted.
+ */
+inline constexpr auto table_capacity = std::size_t{1024};
+
+struct access_counts {
+	std::array<std::uint64_t, access_kind_count> counts{};
+
+	auto operator[](access_kind kind) -> std::uint64_t& {
+		return counts[static_cast<std::size_t>(kind)];
+	}
+
+	auto operator[](access_kind kind) const -> std::uint64_t {
+		return counts[static_cast<std::size_t>(kind)];
+	}
+
+	auto operator+=(const access_counts& other) -> access_counts& {
+		for(auto i = std::size_t{0}; counts.size() > i; ++i) {
+			counts[i] += other.counts[i];
+		}
+		return *this;
+	}
+};
+
+using access_key = std::pair<ecsact_system_like_id, ecsact_component_like_id>;
+
+using report = std::map<access_key, access_counts>;
+
+namespace detail {
+inline constexpr auto empty_key = ~std::uint64_t{0};
+
+inline auto make_key_hash(
+	ecsact_system_like_id    system_id,
+	ecsact_component_like_id component_id
+) -> std::uint64_t {
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(system_id))
+					<< 32) |
+		static_cast<std::uint32_t>(component_id);
+}
+
+/**
+ * Counters of one thread. Only the owning thread inserts keys and increments
+ * counters, so plain relaxed loads and stores are enough. `collect()` may read
+ * the table at any time.
+ */
+struct thread_table {
+	struct entry {
+		std::atomic<std::uint64_t>                                key = empty_key;
+		std::array<std::atomic<std::uint64_t>, access_kind_count> counts{};
+	};
+
+	std::array<entry, table_capacity> entries;
+
+	auto find_or_insert(std::uint64_t key) -> entry* {
+		// fibonacci hashing spreads the packed (system, component) keys
+		auto index = (key * 0x9E3779B97F4A7C15) >> 32;
+		for(auto probe = std::size_t{0}; table_capacity > probe; ++probe) {
+			auto& e = entries[(index + probe) % table_capacity];
+			auto  entry_key = e.key.load(std::memory_order_relaxed);
+			if(entry_key == key) {
+				return &e;
+			}
+			if(entry_key == empty_key) {
+				e.key.store(key, std::memory_order_release);
+				return &e;
+			}
+		}
+		return nullptr;
+	}
+};
+
+struct table_registry {
+	std::mutex                                mutex;
+	std::deque<std::unique_ptr<thread_table>> tables;
+};
+
+inline auto tables() -> table_registry& {
+	static auto registry = table_registry{};
+	return registry;
+}
+
+inline auto this_thread_table() -> thread_table& {
+	thread_local auto table = [] {
+		auto& registry = tables();
+		auto  lk = std::scoped_lock{registry.mutex};
+		return registry.tables.emplace_back(std::make_unique<thread_table>())
+			.get();
+	}();
+	return *table;
+}
+
+/**
+ * System of the innermost `system_scope` on this thread.
+ */
+inline thread_local auto current_system =
+	std::optional<ecsact_system_like_id>{};
+
+inline auto count(
+	ecsact_system_execution_context* ctx,
+	ecsact_component_like_id         component_id,
+	access_kind                      kind
+) -> void {
+	auto system_id = current_system.has_value()
+		? *current_system
+		: ECSACT_CPP_EXECUTION_CONTEXT_FN(id)(ctx);
+	auto entry = this_thread_table().find_or_insert(
+		make_key_hash(system_id, component_id)
+	);
+	if(entry != nullptr) [[likely]] {
+		auto& counter = entry->counts[static_cast<std::size_t>(kind)];
+		counter.store(
+			counter.load(std::memory_order_relaxed) + 1,
+			std::memory_order_relaxed
+		);
+	}
+}
+} // namespace detail
+
+/**
+ * Attributes the accesses counted on this thread to @p system_id for the
+ * lifetime of the scope. Opened by the generated system implementation
+ * functions. Without a scope the system id is queried from the runtime on
+ * every access.
+ */
+class system_scope {
+	std::optional<ecsact_system_like_id> _previous;
+
+public:
+	explicit system_scope(ecsact_system_like_id system_id)
+		: _previous(detail::current_system) {
+		detail::current_system = system_id;
+	}
+
+	system_scope(const system_scope&) = delete;
+	system_scope(system_scope&&) = delete;
+
+	~system_scope() {
+		detail::current_system = _previous;
+	}
+};
+
+/**
+ * Merges the counters of every thread. Pairs without any counted access (e.g.
+ * since the last `reset()`) are left out.
+ */
+inline auto collect() -> report {
+	auto  result = report{};
+	auto& registry = detail::tables();
+	auto  lk = std::scoped_lock{registry.mutex};
+	for(auto& table : registry.tables) {
+		for(auto& entry : table->entries) {
+			auto key = entry.key.load(std::memory_order_acquire);
+			if(key == detail::empty_key) {
+				continue;
+			}
+
+			auto counts = access_counts{};
+			auto any = false;
+			for(auto i = std::size_t{0}; access_kind_count > i; ++i) {
+				counts.counts[i] = entry.counts[i].load(std::memory_order_relaxed);
+				any = any || counts.counts[i] != 0;
+			}
+			if(!any) {
+				continue;
+			}
+
+			auto system_id = static_cast<ecsact_system_like_id>(key >> 32);
+			auto component_id =
+				static_cast<ecsact_component_like_id>(key & 0xFFFFFFFF);
+			result[{system_id, component_id}] += counts;
+		}
+	}
+	return result;
+}
+
+/**
+ * Zeroes the counters of every thread. Accesses counted concurrently with the
+ * reset may be lost or survive it.
+ */
+inline auto reset() -> void {
+	auto& registry = detail::tables();
+	auto  lk = std::scoped_lock{registry.mutex};
+	for(auto& table : registry.tables) {
+		for(auto& entry : table->entries) {
+			for(auto& counter : entry.counts) {
+				counter.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+/**
+ * Capability of a system as declared in the Ecsact file. Generated systems
+ * headers list them in `<package>::declared_capabilities`.
+ */
+struct declared_capability {
+	ecsact_system_like_id    system_id;
+	ecsact_component_like_id component_id;
+	ecsact_system_capability capability;
+};
+
+struct unused_capability {
+	ecsact_system_like_id    system_id;
+	ecsact_component_like_id component_id;
+	ecsact_system_capability capability;
+	/** Declared readable but never read with `get` */
+	bool never_read;
+	/** Declared writable but never written with `update` */
+	bool never_written;
+};
+
+/**
+ * Returns the readwrite capabilities in @p capabilities that were never read or
+ * never written according to @p counts. Candidates for `readonly` or
+ * `writeonly`. Systems without any counted access are skipped since they
+ * likely never ran.
+ */
+inline auto unused_capabilities(
+	const report&                        counts,
+	std::span<const declared_capability> capabilities
+) -> std::vector<unused_capability> {
+	auto result = std::vector<unused_capability>{};
+	for(auto& cap : capabilities) {
+		constexpr auto readwrite = ECSACT_SYS_CAP_READWRITE;
+		if((cap.capability & readwrite) != readwrite) {
+			continue;
+		}
+
+		auto system_ran = false;
+		for(auto&& [key, _] : counts) {
+			if(key.first == cap.system_id) {
+				system_ran = true;
+				break;
+			}
+		}
+		if(!system_ran) {
+			continue;
+		}
+
+		auto itr = counts.find({cap.system_id, cap.component_id});
+		auto component_counts =
+			itr != counts.end() ? itr->second : access_counts{};
+		auto never_read = component_counts[access_kind::get] == 0;
+		auto never_written = component_counts[access_kind::update] == 0;
+		if(never_read || never_written) {
+			result.push_back(unused_capability{
+				.system_id = cap.system_id,
+				.component_id = cap.component_id,
+				.capability = cap.capability,
+				.never_read = never_read,
+				.never_written = never_written,
+			});
+		}
+	}
+	return result;
+}
+
+} // namespace ecsact::access_counters
+#endif
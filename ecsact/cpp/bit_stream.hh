@@ -0,0 +1,162 @@
+#pragma once
+
+#include <bit>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+
+namespace ecsact {
+
+/**
+ * Writes values with an arbitrary number of bits into a byte buffer. Used by
+ * the generated `encode_packed` functions (ECSACT_CPP_PACKED_WIRE_FORMAT) and
+ * may be shared across many components to produce one continuous stream.
+ *
+ * Bits are written least significant first. Writing past the end of the buffer
+ * sets `overflowed()` and further writes are ignored.
+ */
+class bit_writer {
+	std::span<std::byte> _buffer;
+	std::size_t          _bit_pos = 0;
+	bool                 _overflowed = false;
+
+public:
+	explicit bit_writer(std::span<std::byte> buffer) : _buffer(buffer) {
+	}
+
+	/**
+	 * Writes the lowest @p bit_count bits of @p value. @p bit_count must not be
+	 * larger than 64.
+	 */
+	auto write_bits(std::uint64_t value, int bit_count) -> void {
+		if(_overflowed) {
+			return;
+		}
+
+		if(_bit_pos + bit_count > _buffer.size() * 8) {
+			_overflowed = true;
+			return;
+		}
+
+		while(bit_count > 0) {
+			auto byte_index = _bit_pos / 8;
+			auto bit_offset = static_cast<int>(_bit_pos % 8);
+			auto chunk_size = 8 - bit_offset < bit_count ? 8 - bit_offset : bit_count;
+			auto chunk = value & ((std::uint64_t{1} << chunk_size) - 1);
+
+			if(bit_offset == 0) {
+				_buffer[byte_index] = std::byte{0};
+			}
+			_buffer[byte_index] |= static_cast<std::byte>(chunk << bit_offset);
+
+			value >>= chunk_size;
+			bit_count -= chunk_size;
+			_bit_pos += chunk_size;
+		}
+	}
+
+	auto write_bool(bool value) -> void {
+		write_bits(value ? 1 : 0, 1);
+	}
+
+	auto write_f32(float value) -> void {
+		write_bits(std::bit_cast<std::uint32_t>(value), 32);
+	}
+
+	/**
+	 * Writes @p value zigzag and varint encoded in groups of 7 bits followed by a
+	 * continuation bit. Small magnitudes (including -1) take 8 bits.
+	 */
+	auto write_varint(std::int32_t value) -> void {
+		auto zigzag = (static_cast<std::uint32_t>(value) << 1) ^
+			static_cast<std::uint32_t>(value >> 31);
+		do {
+			auto group = zigzag & 0x7F;
+			zigzag >>= 7;
+			write_bits(group | (zigzag != 0 ? 0x80 : 0), 8);
+		} while(zigzag != 0);
+	}
+
+	auto bit_size() const -> std::size_t {
+		return _bit_pos;
+	}
+
+	/** Number of bytes of the buffer touched so far */
+	auto byte_size() const -> std::size_t {
+		return (_bit_pos + 7) / 8;
+	}
+
+	auto overflowed() const -> bool {
+		return _overflowed;
+	}
+};
+
+/**
+ * Reads values written by `bit_writer`. Reading past the end of the buffer sets
+ * `overflowed()` and yields zeros.
+ */
+class bit_reader {
+	std::span<const std::byte> _buffer;
+	std::size_t                _bit_pos = 0;
+	bool                       _overflowed = false;
+
+public:
+	explicit bit_reader(std::span<const std::byte> buffer) : _buffer(buffer) {
+	}
+
+	auto read_bits(int bit_count) -> std::uint64_t {
+		if(_overflowed || _bit_pos + bit_count > _buffer.size() * 8) {
+			_overflowed = true;
+			return 0;
+		}
+
+		auto value = std::uint64_t{0};
+		auto shift = 0;
+		while(bit_count > 0) {
+			auto byte_index = _bit_pos / 8;
+			auto bit_offset = static_cast<int>(_bit_pos % 8);
+			auto chunk_size = 8 - bit_offset < bit_count ? 8 - bit_offset : bit_count;
+			auto byte = std::to_integer<std::uint64_t>(_buffer[byte_index]);
+			auto mask = (std::uint64_t{1} << chunk_size) - 1;
+			auto chunk = (byte >> bit_offset) & mask;
+
+			value |= chunk << shift;
+			shift += chunk_size;
+			bit_count -= chunk_size;
+			_bit_pos += chunk_size;
+		}
+
+		return value;
+	}
+
+	auto read_bool() -> bool {
+		return read_bits(1) != 0;
+	}
+
+	auto read_f32() -> float {
+		return std::bit_cast<float>(static_cast<std::uint32_t>(read_bits(32)));
+	}
+
+	auto read_varint() -> std::int32_t {
+		auto zigzag = std::uint32_t{0};
+		for(auto shift = 0; 35 > shift; shift += 7) {
+			auto group = static_cast<std::uint32_t>(read_bits(8));
+			zigzag |= (group & 0x7F) << shift;
+			if((group & 0x80) == 0) {
+				break;
+			}
+		}
+
+		return static_cast<std::int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+	}
+
+	auto bit_size() const -> std::size_t {
+		return _bit_pos;
+	}
+
+	auto overflowed() const -> bool {
+		return _overflowed;
+	}
+};
+
+} // namespace ecsact
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "ecsact/runtime/dynamic.h"
+#include "ecsact/runtime/common.h"
+#include "ecsact/cpp/execution_context.hh"
+
+namespace ecsact {
+
+/**
+ * Records structural changes (add, remove and generate) made by a system
+ * execution and replays them against the runtime in recording order when
+ * `flush()` is called. Component data is copied into an arena that is reused
+ * between flushes so steady state recording does not allocate.
+ *
+ * Used by the generated contexts and trampolines when
+ * ECSACT_CPP_COMMAND_BUFFER is defined. All trampolines running on a thread
+ * share `command_buffer::this_thread()`. The trampoline flushes once the system
+ * impl (or the whole `__batch` loop) returns, while the execution contexts are
+ * still valid. Structural changes are therefore not visible to the system until
+ * the next execution.
+ */
+class command_buffer {
+	enum class command_kind : std::uint8_t {
+		add,
+		remove,
+		generate,
+	};
+
+	struct command {
+		command_kind                     kind;
+		ecsact_system_execution_context* ctx;
+		ecsact_component_like_id         component_id;
+		int32_t                          component_count;
+		std::size_t                      data_offset;
+	};
+
+	static constexpr auto arena_alignment = alignof(std::max_align_t);
+
+	std::vector<command>   _commands;
+	std::vector<std::byte> _arena;
+
+	auto allocate(std::size_t size) -> std::size_t {
+		auto offset = (_arena.size() + arena_alignment - 1) / arena_alignment *
+			arena_alignment;
+		_arena.resize(offset + size);
+		return offset;
+	}
+
+	template<typename C>
+	auto store(const C& component) -> std::size_t {
+		static_assert(std::is_trivially_copyable_v<C>);
+		auto offset = allocate(sizeof(C));
+		std::memcpy(_arena.data() + offset, &component, sizeof(C));
+		return offset;
+	}
+
+public:
+	/**
+	 * Nothing is allocated up front unless requested. The buffer grows on demand
+	 * and keeps its capacity between flushes.
+	 */
+	command_buffer(
+		std::size_t reserved_commands = 0,
+		std::size_t reserved_bytes = 0
+	) {
+		_commands.reserve(reserved_commands);
+		_arena.reserve(reserved_bytes);
+	}
+
+	command_buffer(const command_buffer&) = delete;
+	command_buffer(command_buffer&&) = default;
+
+	/**
+	 * Buffer shared by every generated trampoline running on the calling thread.
+	 * Its capacity is sized by the largest execution seen on the thread rather
+	 * than reserved once per system.
+	 */
+	static auto this_thread() -> command_buffer& {
+		thread_local auto buffer = command_buffer{};
+		return buffer;
+	}
+
+	template<typename C>
+		requires(!std::is_empty_v<C>)
+	auto add(const execution_context& ctx, const C& new_component) -> void {
+		ECSACT_CPP_COUNT_ACCESS(ctx._ctx, C::id, add);
+		_commands.push_back(command{
+			.kind = command_kind::add,
+			.ctx = ctx._ctx,
+			.component_id = ecsact_id_cast<ecsact_component_like_id>(C::id),
+			.component_count = 1,
+			.data_offset = store(new_component),
+		});
+	}
+
+	template<typename C>
+		requires(std::is_empty_v<C>)
+	auto add(const execution_context& ctx) -> void {
+		ECSACT_CPP_COUNT_ACCESS(ctx._ctx, C::id, add);
+		_commands.push_back(command{
+			.kind = command_kind::add,
+			.ctx = ctx._ctx,
+			.component_id = ecsact_id_cast<ecsact_component_like_id>(C::id),
+			.component_count = 0,
+			.data_offset = 0,
+		});
+	}
+
+	template<typename C>
+	auto remove(const execution_context& ctx) -> void {
+		ECSACT_CPP_COUNT_ACCESS(ctx._ctx, C::id, remove);
+		_commands.push_back(command{
+			.kind = command_kind::remove,
+			.ctx = ctx._ctx,
+			.component_id = ecsact_id_cast<ecsact_component_like_id>(C::id),
+			.component_count = 0,
+			.data_offset = 0,
+		});
+	}
+
+	/**
+	 * Records the generation of one entity with @p components. The arena holds a
+	 * header of data pointers (filled in at flush time), data offsets and
+	 * component ids followed by the component data.
+	 */
+	template<typename... C>
+		requires(sizeof...(C) > 0)
+	auto generate(const execution_context& ctx, const C&... components) -> void {
+		constexpr auto count = sizeof...(C);
+		constexpr auto header_size = count *
+			(sizeof(const void*) + sizeof(std::size_t) + sizeof(ecsact_component_id));
+
+		auto header_offset = allocate(header_size);
+
+		const std::size_t         data_offsets[]{store(components)...};
+		const ecsact_component_id ids[]{C::id...};
+
+		auto header = _arena.data() + header_offset;
+		std::memcpy(
+			header + count * sizeof(const void*),
+			data_offsets,
+			sizeof(data_offsets)
+		);
+		std::memcpy(
+			header + count * (sizeof(const void*) + sizeof(std::size_t)),
+			ids,
+			sizeof(ids)
+		);
+
+		_commands.push_back(command{
+			.kind = command_kind::generate,
+			.ctx = ctx._ctx,
+			.component_id = {},
+			.component_count = static_cast<int32_t>(count),
+			.data_offset = header_offset,
+		});
+	}
+
+	template<typename... C>
+		requires(sizeof...(C) > 0)
+	auto generate_n(
+		const execution_context& ctx,
+		std::size_t              count,
+		const C&... components
+	) -> void {
+		for(auto i = std::size_t{0}; count > i; ++i) {
+			generate(ctx, components...);
+		}
+	}
+
+	template<typename... C>
+		requires(sizeof...(C) > 0)
+	auto generate_batch(
+		const execution_context& ctx,
+		std::span<const C>... components
+	) -> void {
+		const auto sizes = std::array{components.size()...};
+		const auto count = sizes[0];
+		assert(
+			std::ranges::all_of(sizes, [&](auto size) { return size == count; }) &&
+			"generate_batch spans must have the same length"
+		);
+		for(auto i = std::size_t{0}; count > i; ++i) {
+			generate(ctx, components[i]...);
+		}
+	}
+
+	auto size() const -> std::size_t {
+		return _commands.size();
+	}
+
+	auto empty() const -> bool {
+		return _commands.empty();
+	}
+
+	/**
+	 * Replays every recorded command in order and clears the buffer. Capacity is
+	 * kept for the next execution.
+	 */
+	auto flush() -> void {
+		const auto add_fn = ECSACT_CPP_EXECUTION_CONTEXT_FN(add);
+		const auto remove_fn = ECSACT_CPP_EXECUTION_CONTEXT_FN(remove);
+		const auto generate_fn = ECSACT_CPP_EXECUTION_CONTEXT_FN(generate);
+		auto*      arena = _arena.data();
+
+		for(auto& cmd : _commands) {
+			switch(cmd.kind) {
+				case command_kind::add:
+					add_fn(
+						cmd.ctx,
+						cmd.component_id,
+						cmd.component_count > 0 ? arena + cmd.data_offset : nullptr
+					);
+					break;
+				case command_kind::remove:
+					remove_fn(cmd.ctx, cmd.component_id, nullptr);
+					break;
+				case command_kind::generate: {
+					auto count = static_cast<std::size_t>(cmd.component_count);
+					auto header = arena + cmd.data_offset;
+					auto data = reinterpret_cast<const void**>(header);
+					auto data_offsets = reinterpret_cast<std::size_t*>(
+						header + count * sizeof(const void*)
+					);
+					auto ids = reinterpret_cast<ecsact_component_id*>(
+						header + count * (sizeof(const void*) + sizeof(std::size_t))
+					);
+					for(auto i = std::size_t{0}; count > i; ++i) {
+						data[i] = arena + data_offsets[i];
+					}
+					generate_fn(cmd.ctx, cmd.component_count, ids, data);
+					break;
+				}
+			}
+		}
+
+		_commands.clear();
+		_arena.clear();
+	}
+};
+
+} // namespace ecsact
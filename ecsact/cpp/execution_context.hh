@@ -1,13 +1,258 @@
 #pragma once
 
+#include <span>
+#include <array>
+#include <cassert>
+#include <tuple>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <utility>
 #include <type_traits>
 #include "ecsact/runtime/dynamic.h"
 #include "ecsact/runtime/common.h"
+#include "ecsact/cpp/execution_dispatch.hh"
+#include "ecsact/cpp/access_counters.hh"
+#include "ecsact/cpp/redundant_access.hh"
 
 struct ecsact_system_execution_context;
 
+#ifdef ECSACT_CPP_RUNTIME_GET_PTR
+/**
+ * Optional runtime extension used by `ecsact::execution_context::view`. Returns
+ * a pointer to the component data in the runtime's storage. The pointer must
+ * stay valid until the system execution for @p context returns.
+ *
+ * With ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME this is a function pointer defined
+ * here that stays null unless the runtime assigns it after loading the system
+ * implementations. `view` copies the component with `get` while it is null.
+ */
+ECSACT_DYNAMIC_API_FN(const void*, ecsact_system_execution_context_get_ptr)(
+	struct ecsact_system_execution_context* context,
+	ecsact_component_like_id                component_id,
+	const void* const*                      assoc_field_values
+);
+#	ifdef ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME
+extern "C" {
+inline decltype(ecsact_system_execution_context_get_ptr)
+	ecsact_system_execution_context_get_ptr = nullptr;
+}
+#	endif
+#endif
+
+#ifdef ECSACT_CPP_RUNTIME_ACTION_PTR
+/**
+ * Optional runtime extension used by `ecsact::execution_context::action_ptr`.
+ * Returns a pointer to the action payload of the action execution @p context
+ * belongs to (including child system contexts). The pointer must stay valid
+ * until the action execution, including its child systems, completes.
+ *
+ * With ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME this is a function pointer defined
+ * here that stays null unless the runtime assigns it after loading the system
+ * implementations. `action_ptr` returns null while it is.
+ */
+ECSACT_DYNAMIC_API_FN(const void*, ecsact_system_execution_context_action_ptr)(
+	struct ecsact_system_execution_context* context
+);
+#	ifdef ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME
+extern "C" {
+inline decltype(ecsact_system_execution_context_action_ptr)
+	ecsact_system_execution_context_action_ptr = nullptr;
+}
+#	endif
+#endif
+
 namespace ecsact {
 
+/**
+ * Read only component returned by `execution_context::view<C>()`. Access the
+ * component with `*` or `->`. When the runtime provides
+ * `ecsact_system_execution_context_get_ptr` (ECSACT_CPP_RUNTIME_GET_PTR) the
+ * view points straight into runtime storage, otherwise it holds a copy.
+ *
+ * A view holding a copy points into itself, so it may not be copied or moved.
+ * It must not outlive the system execution it was created in.
+ */
+template<typename C>
+class component_view {
+	const C* const _ptr;
+
+	union {
+		C _copy;
+	};
+
+public:
+	ECSACT_ALWAYS_INLINE explicit component_view(const C* ptr) : _ptr(ptr) {
+	}
+
+	ECSACT_ALWAYS_INLINE explicit component_view(const C& copy)
+		: _ptr(&_copy), _copy(copy) {
+	}
+
+	component_view(const component_view&) = delete;
+	component_view(component_view&&) = delete;
+
+	ECSACT_ALWAYS_INLINE auto operator*() const -> const C& {
+		return *_ptr;
+	}
+
+	ECSACT_ALWAYS_INLINE auto operator->() const -> const C* {
+		return _ptr;
+	}
+};
+
+template<typename C>
+using component_view_t = component_view<C>;
+
+namespace detail {
+template<typename T, typename... U>
+concept one_of = (std::is_same_v<T, U> || ...);
+
+template<typename... T>
+struct type_list {};
+
+/**
+ * `true` when the components `T...` satisfy a system `generates` block with the
+ * `Required` and `Optional` component lists: every required component is
+ * present and every component is either required or optional.
+ */
+template<typename Required, typename Optional, typename... T>
+constexpr bool generates_match_v = false;
+
+template<typename... R, typename... O, typename... T>
+constexpr bool generates_match_v<type_list<R...>, type_list<O...>, T...> =
+	(one_of<R, T...> && ...) && (one_of<T, R..., O...> && ...);
+} // namespace detail
+
+/**
+ * Handle returned by `modify<C>()`. Holds a copy of the component that may be
+ * mutated freely. When the handle is destroyed the component is written back
+ * with `update` only if its bytes changed (generated components compare with
+ * `bitwise_equal` which ignores padding), so unchanged components do not
+ * produce update events in the runtime.
+ */
+template<typename C, typename Context>
+class component_modifier {
+	Context& _ctx;
+	C        _original;
+	C        _value;
+
+public:
+	ECSACT_ALWAYS_INLINE component_modifier(Context& ctx)
+		: _ctx(ctx), _value(ctx.template get<C>()) {
+		std::memcpy(&_original, &_value, sizeof(C));
+	}
+
+	component_modifier(const component_modifier&) = delete;
+	component_modifier(component_modifier&&) = delete;
+
+	ECSACT_ALWAYS_INLINE ~component_modifier() {
+		if(changed()) {
+			_ctx.update(_value);
+		}
+	}
+
+	ECSACT_ALWAYS_INLINE auto changed() const -> bool {
+		if constexpr(requires { C::bitwise_equal(_original, _value); }) {
+			return !C::bitwise_equal(_original, _value);
+		} else {
+			return std::memcmp(&_original, &_value, sizeof(C)) != 0;
+		}
+	}
+
+	ECSACT_ALWAYS_INLINE auto operator*() -> C& {
+		return _value;
+	}
+
+	ECSACT_ALWAYS_INLINE auto operator->() -> C* {
+		return &_value;
+	}
+};
+
+/**
+ * Accessor for a component with assoc fields returned by `assoc<C>(fields...)`.
+ * Binds the assoc field values so repeated `get`, `update`, `has` and
+ * `stream_toggle` calls don't pass them again. Only the array of pointers
+ * handed to the runtime is built once; the runtime still resolves the
+ * associated entity on every call. `update` is only available when @p Writable
+ * is `true`.
+ *
+ * The accessor points into itself and may not be copied or moved. It must not
+ * outlive the system execution it was created in.
+ */
+template<typename C, bool Writable, typename... AssocFields>
+class assoc_accessor {
+	static_assert(
+		sizeof...(AssocFields) > 0,
+		"must be created with assoc fields"
+	);
+
+	ecsact_system_execution_context* const _ctx;
+	const std::tuple<AssocFields...>       _values;
+	const void*                            _value_ptrs[sizeof...(AssocFields)];
+
+public:
+	ECSACT_ALWAYS_INLINE assoc_accessor(
+		ecsact_system_execution_context* ctx,
+		const AssocFields&... assoc_fields
+	)
+		: _ctx(ctx), _values(assoc_fields...) {
+		std::apply(
+			[this](const AssocFields&... values) {
+				auto index = 0;
+				((_value_ptrs[index++] = &values), ...);
+			},
+			_values
+		);
+	}
+
+	assoc_accessor(const assoc_accessor&) = delete;
+	assoc_accessor(assoc_accessor&&) = delete;
+
+	ECSACT_ALWAYS_INLINE auto get() const -> C {
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, get);
+		auto comp = C{};
+		ECSACT_CPP_EXECUTION_CONTEXT_FN(get)(
+			_ctx,
+			ecsact_id_cast<ecsact_component_like_id>(C::id),
+			&comp,
+			_value_ptrs
+		);
+		return comp;
+	}
+
+	ECSACT_ALWAYS_INLINE auto update(const C& updated_component) -> void
+		requires(Writable)
+	{
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, update);
+		ECSACT_CPP_EXECUTION_CONTEXT_FN(update)(
+			_ctx,
+			ecsact_id_cast<ecsact_component_like_id>(C::id),
+			&updated_component,
+			_value_ptrs
+		);
+	}
+
+	ECSACT_ALWAYS_INLINE auto has() const -> bool {
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, has);
+		return ECSACT_CPP_EXECUTION_CONTEXT_FN(has)(
+			_ctx,
+			ecsact_id_cast<ecsact_component_like_id>(C::id),
+			_value_ptrs
+		);
+	}
+
+	ECSACT_ALWAYS_INLINE auto stream_toggle(bool enable_stream_data) -> void {
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, stream_toggle);
+		ECSACT_CPP_EXECUTION_CONTEXT_FN(stream_toggle)(
+			_ctx,
+			C::id,
+			enable_stream_data,
+			_value_ptrs
+		);
+	}
+};
+
 struct execution_context {
 	[[no_unique_address]] ecsact_system_execution_context* const _ctx;
 
@@ -25,10 +270,30 @@ struct execution_context {
 	template<typename A>
 	ECSACT_ALWAYS_INLINE auto action() const -> A {
 		A action;
-		ecsact_system_execution_context_action(_ctx, &action);
+		ECSACT_CPP_EXECUTION_CONTEXT_FN(action)(_ctx, &action);
 		return action;
 	}
 
+#ifdef ECSACT_CPP_RUNTIME_ACTION_PTR
+	/**
+	 * Pointer to the action payload in runtime storage. Unlike `action<A>()`
+	 * the payload is not copied. Returns null when the runtime did not provide
+	 * `ecsact_system_execution_context_action_ptr`, in which case use
+	 * `action<A>()`.
+	 */
+	template<typename A>
+	ECSACT_ALWAYS_INLINE auto action_ptr() const -> const A* {
+#	ifdef ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME
+		if(ecsact_system_execution_context_action_ptr == nullptr) [[unlikely]] {
+			return nullptr;
+		}
+#	endif
+		return static_cast<const A*>(
+			ecsact_system_execution_context_action_ptr(_ctx)
+		);
+	}
+#endif
+
 	template<typename C, typename... AssocFields>
 		requires(!std::is_empty_v<C>)
 	ECSACT_ALWAYS_INLINE auto get(AssocFields&&... assoc_fields) const -> C {
@@ -39,6 +304,7 @@ struct execution_context {
 			);
 		}
 
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, get);
 		auto comp = C{};
 
 		if constexpr(sizeof...(AssocFields) > 0) {
@@ -46,19 +312,20 @@ struct execution_context {
 				&assoc_fields...,
 			};
 
-			ecsact_system_execution_context_get(
+			ECSACT_CPP_EXECUTION_CONTEXT_FN(get)(
 				_ctx,
 				ecsact_id_cast<ecsact_component_like_id>(C::id),
 				&comp,
 				assoc_field_values
 			);
 		} else {
-			ecsact_system_execution_context_get(
+			ECSACT_CPP_EXECUTION_CONTEXT_FN(get)(
 				_ctx,
 				ecsact_id_cast<ecsact_component_like_id>(C::id),
 				&comp,
 				nullptr
 			);
+			ECSACT_CPP_TRACK_GET(_ctx, comp);
 		}
 		return comp;
 	}
@@ -76,24 +343,178 @@ struct execution_context {
 			);
 		}
 
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, update);
 		if constexpr(sizeof...(AssocFields) > 0) {
 			const void* assoc_field_values[sizeof...(AssocFields)] = {
 				&assoc_fields...,
 			};
-			ecsact_system_execution_context_update(
+			ECSACT_CPP_EXECUTION_CONTEXT_FN(update)(
 				_ctx,
 				ecsact_id_cast<ecsact_component_like_id>(C::id),
 				&updated_component,
 				assoc_field_values
 			);
 		} else {
-			ecsact_system_execution_context_update(
+			ECSACT_CPP_EXECUTION_CONTEXT_FN(update)(
 				_ctx,
 				ecsact_id_cast<ecsact_component_like_id>(C::id),
 				&updated_component,
 				nullptr
 			);
+			ECSACT_CPP_TRACK_UPDATE(_ctx, updated_component);
+		}
+	}
+
+	/**
+	 * Get an accessor to a component with assoc fields that can be read and
+	 * written repeatedly without passing the assoc fields again. See
+	 * `assoc_accessor`.
+	 */
+	template<typename C, typename... AssocFields>
+		requires(!std::is_empty_v<C> && sizeof...(AssocFields) > 0)
+	ECSACT_ALWAYS_INLINE auto assoc(const AssocFields&... assoc_fields)
+		-> assoc_accessor<C, true, AssocFields...> {
+		static_assert(C::has_assoc_fields, "component has no assoc fields");
+		return {_ctx, assoc_fields...};
+	}
+
+	/**
+	 * Read only access to a component. Avoids copying the component out of the
+	 * runtime when the runtime supports it. See `component_view`.
+	 */
+	template<typename C, typename... AssocFields>
+		requires(!std::is_empty_v<C>)
+	ECSACT_ALWAYS_INLINE auto view( //
+		AssocFields&&... assoc_fields
+	) const -> component_view<C> {
+#ifdef ECSACT_CPP_RUNTIME_GET_PTR
+		if constexpr(C::has_assoc_fields) {
+			static_assert(
+				sizeof...(AssocFields) > 0,
+				"must be called with assoc fields"
+			);
+		}
+
+#	ifdef ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME
+		if(ecsact_system_execution_context_get_ptr == nullptr) [[unlikely]] {
+			return component_view<C>{
+				get<C>(std::forward<AssocFields>(assoc_fields)...)
+			};
+		}
+#	endif
+
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, get);
+		if constexpr(sizeof...(AssocFields) > 0) {
+			const void* assoc_field_values[sizeof...(AssocFields)] = {
+				&assoc_fields...,
+			};
+			return component_view<C>{
+				static_cast<const C*>(ecsact_system_execution_context_get_ptr(
+					_ctx,
+					ecsact_id_cast<ecsact_component_like_id>(C::id),
+					assoc_field_values
+				))
+			};
+		} else {
+			return component_view<C>{
+				static_cast<const C*>(ecsact_system_execution_context_get_ptr(
+					_ctx,
+					ecsact_id_cast<ecsact_component_like_id>(C::id),
+					nullptr
+				))
+			};
 		}
+#else
+		return component_view<C>{
+			get<C>(std::forward<AssocFields>(assoc_fields)...)
+		};
+#endif
+	}
+
+	/**
+	 * Get several components at once. Behaves like calling `get<C>()` for each
+	 * component, but the runtime function is only resolved once for the whole
+	 * batch. Components with assoc fields are not supported.
+	 */
+	template<typename... C>
+		requires(sizeof...(C) > 0 && (!std::is_empty_v<C> && ...))
+	ECSACT_ALWAYS_INLINE auto get_many() const -> std::tuple<C...> {
+		static_assert(
+			(!C::has_assoc_fields && ...),
+			"get_many cannot be used with components that have assoc fields"
+		);
+
+		const auto get_fn = ECSACT_CPP_EXECUTION_CONTEXT_FN(get);
+		auto       comps = std::tuple<C...>{};
+
+		std::apply(
+			[&](C&... comp) {
+#ifdef ECSACT_CPP_EXECUTION_CONTEXT_COUNTERS
+				(ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, get), ...);
+#endif
+				(get_fn(
+					 _ctx,
+					 ecsact_id_cast<ecsact_component_like_id>(C::id),
+					 &comp,
+					 nullptr
+				 ),
+				 ...);
+#ifdef ECSACT_CPP_REDUNDANT_ACCESS_CHECK
+				(ECSACT_CPP_TRACK_GET(_ctx, comp), ...);
+#endif
+			},
+			comps
+		);
+
+		return comps;
+	}
+
+	/**
+	 * Update several components at once. Behaves like calling `update(c)` for
+	 * each component, but the runtime function is only resolved once for the
+	 * whole batch. Components with assoc fields are not supported.
+	 */
+	template<typename... C>
+		requires(sizeof...(C) > 0 && (!std::is_empty_v<C> && ...))
+	ECSACT_ALWAYS_INLINE auto update_many( //
+		const C&... updated_components
+	) -> void {
+		static_assert(
+			(!C::has_assoc_fields && ...),
+			"update_many cannot be used with components that have assoc fields"
+		);
+
+		const auto update_fn = ECSACT_CPP_EXECUTION_CONTEXT_FN(update);
+
+#ifdef ECSACT_CPP_EXECUTION_CONTEXT_COUNTERS
+		(ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, update), ...);
+#endif
+
+		(update_fn(
+			 _ctx,
+			 ecsact_id_cast<ecsact_component_like_id>(C::id),
+			 &updated_components,
+			 nullptr
+		 ),
+		 ...);
+#ifdef ECSACT_CPP_REDUNDANT_ACCESS_CHECK
+		(ECSACT_CPP_TRACK_UPDATE(_ctx, updated_components), ...);
+#endif
+	}
+
+	/**
+	 * Get a handle to mutate a component in place. See `component_modifier`.
+	 */
+	template<typename C>
+		requires(!std::is_empty_v<C>)
+	ECSACT_ALWAYS_INLINE auto modify()
+		-> component_modifier<C, execution_context> {
+		static_assert(
+			!C::has_assoc_fields,
+			"modify cannot be used with components that have assoc fields"
+		);
+
+		return component_modifier<C, execution_context>{*this};
 	}
 
 	template<typename C, typename... AssocFields>
@@ -105,21 +526,24 @@ struct execution_context {
 			);
 		}
 
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, has);
 		if constexpr(sizeof...(AssocFields) > 0) {
 			const void* assoc_field_values[sizeof...(AssocFields)] = {
 				&assoc_fields...,
 			};
-			return ecsact_system_execution_context_has(
+			return ECSACT_CPP_EXECUTION_CONTEXT_FN(has)(
 				_ctx,
 				ecsact_id_cast<ecsact_component_like_id>(C::id),
 				assoc_field_values
 			);
 		} else {
-			return ecsact_system_execution_context_has(
+			auto result = ECSACT_CPP_EXECUTION_CONTEXT_FN(has)(
 				_ctx,
 				ecsact_id_cast<ecsact_component_like_id>(C::id),
 				nullptr
 			);
+			ECSACT_CPP_TRACK_HAS(_ctx, C::id, result);
+			return result;
 		}
 	}
 
@@ -134,18 +558,19 @@ struct execution_context {
 				"must be called with assoc fields"
 			);
 		}
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, stream_toggle);
 		if constexpr(sizeof...(AssocFields) > 0) {
 			const void* assoc_field_values[sizeof...(AssocFields)] = {
 				&assoc_fields...,
 			};
-			ecsact_system_execution_context_stream_toggle(
+			ECSACT_CPP_EXECUTION_CONTEXT_FN(stream_toggle)(
 				_ctx,
 				C::id,
 				enable_stream_data,
 				assoc_field_values
 			);
 		} else {
-			ecsact_system_execution_context_stream_toggle(
+			ECSACT_CPP_EXECUTION_CONTEXT_FN(stream_toggle)(
 				_ctx,
 				C::id,
 				enable_stream_data,
@@ -157,7 +582,8 @@ struct execution_context {
 	template<typename C>
 		requires(!std::is_empty_v<C>)
 	ECSACT_ALWAYS_INLINE auto add(const C& new_component) -> void {
-		ecsact_system_execution_context_add(
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, add);
+		ECSACT_CPP_EXECUTION_CONTEXT_FN(add)(
 			_ctx,
 			ecsact_id_cast<ecsact_component_like_id>(C::id),
 			&new_component
@@ -167,7 +593,8 @@ struct execution_context {
 	template<typename C>
 		requires(std::is_empty_v<C>)
 	ECSACT_ALWAYS_INLINE auto add() -> void {
-		ecsact_system_execution_context_add(
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, add);
+		ECSACT_CPP_EXECUTION_CONTEXT_FN(add)(
 			_ctx,
 			ecsact_id_cast<ecsact_component_like_id>(C::id),
 			nullptr
@@ -176,7 +603,8 @@ struct execution_context {
 
 	template<typename C>
 	ECSACT_ALWAYS_INLINE auto remove() -> void {
-		ecsact_system_execution_context_remove(
+		ECSACT_CPP_COUNT_ACCESS(_ctx, C::id, remove);
+		ECSACT_CPP_EXECUTION_CONTEXT_FN(remove)(
 			_ctx,
 			ecsact_id_cast<ecsact_component_like_id>(C::id),
 			nullptr
@@ -185,10 +613,10 @@ struct execution_context {
 
 	template<typename... C>
 	ECSACT_ALWAYS_INLINE auto generate(C&&... components) -> void {
-		ecsact_component_id component_ids[]{C::id...};
+		ecsact_component_id component_ids[]{std::remove_cvref_t<C>::id...};
 		const void*         components_data[]{&components...};
 
-		ecsact_system_execution_context_generate(
+		ECSACT_CPP_EXECUTION_CONTEXT_FN(generate)(
 			_ctx,
 			sizeof...(C),
 			component_ids,
@@ -196,30 +624,78 @@ struct execution_context {
 		);
 	}
 
+	/**
+	 * Generates @p count entities with a copy of @p components each. The id and
+	 * data arrays handed to the runtime are built once for the whole batch.
+	 */
+	template<typename... C>
+		requires(sizeof...(C) > 0)
+	auto generate_n(std::size_t count, const C&... components) -> void {
+		const auto generate_fn = ECSACT_CPP_EXECUTION_CONTEXT_FN(generate);
+
+		ecsact_component_id component_ids[]{C::id...};
+		const void*         components_data[]{&components...};
+
+		for(auto i = std::size_t{0}; count > i; ++i) {
+			generate_fn(_ctx, sizeof...(C), component_ids, components_data);
+		}
+	}
+
+	/**
+	 * Generates one entity per element of the given contiguous component arrays.
+	 * Entity `i` gets `components[i]...`. All spans must have the same length,
+	 * which is asserted in debug builds.
+	 *
+	 * Spans are not deduced from containers, so pass the component types
+	 * explicitly when calling with e.g. a `std::vector`:
+	 * `ctx.generate_batch<A, B>(as, bs)`
+	 */
+	template<typename... C>
+		requires(sizeof...(C) > 0)
+	auto generate_batch(std::span<const C>... components) -> void {
+		const auto generate_fn = ECSACT_CPP_EXECUTION_CONTEXT_FN(generate);
+		const auto sizes = std::array{components.size()...};
+		const auto count = sizes[0];
+		assert(
+			std::ranges::all_of(sizes, [&](auto size) { return size == count; }) &&
+			"generate_batch spans must have the same length"
+		);
+
+		ecsact_component_id component_ids[]{C::id...};
+		const void*         components_data[sizeof...(C)];
+
+		for(auto i = std::size_t{0}; count > i; ++i) {
+			auto data_index = 0;
+			((components_data[data_index++] = components.data() + i), ...);
+			generate_fn(_ctx, sizeof...(C), component_ids, components_data);
+		}
+	}
+
 	ECSACT_ALWAYS_INLINE auto parent() const -> const execution_context {
 		return execution_context::make_readonly(
-			ecsact_system_execution_context_parent(_ctx)
+			ECSACT_CPP_EXECUTION_CONTEXT_FN(parent)(_ctx)
 		);
 	}
 
 	ECSACT_ALWAYS_INLINE auto same(const execution_context& other) const -> bool {
-		return ecsact_system_execution_context_same(_ctx, other._ctx);
+		return ECSACT_CPP_EXECUTION_CONTEXT_FN(same)(_ctx, other._ctx);
 	}
 
 	ECSACT_ALWAYS_INLINE auto other( //
 		ecsact_system_assoc_id assoc_id
 	) -> execution_context {
+		ECSACT_CPP_TRACK_OTHER(_ctx, assoc_id);
 		return execution_context{
-			ecsact_system_execution_context_other(_ctx, assoc_id)
+			ECSACT_CPP_EXECUTION_CONTEXT_FN(other)(_ctx, assoc_id)
 		};
 	}
 
 	ECSACT_ALWAYS_INLINE auto id() const -> ecsact_system_like_id {
-		return ecsact_system_execution_context_id(_ctx);
+		return ECSACT_CPP_EXECUTION_CONTEXT_FN(id)(_ctx);
 	}
 
 	ECSACT_ALWAYS_INLINE auto entity() const -> ecsact_entity_id {
-		return ecsact_system_execution_context_entity(_ctx);
+		return ECSACT_CPP_EXECUTION_CONTEXT_FN(entity)(_ctx);
 	}
 };
 
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <type_traits>
+#include "ecsact/runtime/dynamic.h"
+
+/**
+ * Calls the runtime execution context function @p name, e.g.
+ * `ECSACT_CPP_EXECUTION_CONTEXT_FN(get)(...)`.
+ *
+ * When ECSACT_CPP_EXECUTION_CONTEXT_DISPATCH is defined the call goes through
+ * `ecsact::detail::execution_dispatch`, a single table of function pointers
+ * that is filled once. Otherwise the runtime function is called directly. That
+ * is a direct static call when the runtime is linked statically, or a call
+ * through the individual `ecsact_system_execution_context_*` globals with
+ * ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME.
+ */
+#ifdef ECSACT_CPP_EXECUTION_CONTEXT_DISPATCH
+#	define ECSACT_CPP_EXECUTION_CONTEXT_FN(name) \
+		::ecsact::detail::execution_dispatch->name
+#else
+#	define ECSACT_CPP_EXECUTION_CONTEXT_FN(name) \
+		ecsact_system_execution_context_##name
+#endif
+
+#ifdef ECSACT_CPP_EXECUTION_CONTEXT_DISPATCH
+namespace ecsact {
+
+namespace detail {
+/**
+ * Function pointer type of a runtime function, whether it is declared as a
+ * function or as a function pointer (ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME).
+ */
+template<typename Fn>
+using fn_ptr_t = std::add_pointer_t<std::remove_pointer_t<Fn>>;
+} // namespace detail
+
+/**
+ * Every runtime execution context function used by `ecsact::execution_context`
+ * in one contiguous table. Kept together so a system execution touches one
+ * cache line of pointers instead of one global per function.
+ */
+struct execution_context_dispatch {
+#define ECSACT_CPP_DISPATCH_FN_(name) \
+	detail::fn_ptr_t<decltype(ecsact_system_execution_context_##name)> name
+	ECSACT_CPP_DISPATCH_FN_(action);
+	ECSACT_CPP_DISPATCH_FN_(add);
+	ECSACT_CPP_DISPATCH_FN_(remove);
+	ECSACT_CPP_DISPATCH_FN_(get);
+	ECSACT_CPP_DISPATCH_FN_(update);
+	ECSACT_CPP_DISPATCH_FN_(has);
+	ECSACT_CPP_DISPATCH_FN_(generate);
+	ECSACT_CPP_DISPATCH_FN_(parent);
+	ECSACT_CPP_DISPATCH_FN_(same);
+	ECSACT_CPP_DISPATCH_FN_(other);
+	ECSACT_CPP_DISPATCH_FN_(id);
+	ECSACT_CPP_DISPATCH_FN_(entity);
+	ECSACT_CPP_DISPATCH_FN_(stream_toggle);
+#undef ECSACT_CPP_DISPATCH_FN_
+};
+
+namespace detail {
+inline execution_context_dispatch execution_dispatch_storage{};
+inline std::atomic_bool           execution_dispatch_loaded = false;
+inline std::once_flag             execution_dispatch_once;
+
+/**
+ * Read only access to the dispatch table used by
+ * ECSACT_CPP_EXECUTION_CONTEXT_FN. Only `load_execution_context_dispatch`
+ * writes the table.
+ */
+inline constexpr const execution_context_dispatch* execution_dispatch =
+	&execution_dispatch_storage;
+} // namespace detail
+
+/**
+ * Fills the dispatch table from the runtime functions. Must be called again if
+ * the runtime functions change (e.g. the runtime was reloaded without
+ * reloading the system implementations).
+ *
+ * The table is read without synchronization while systems execute, so this
+ * must not run concurrently with any system execution.
+ */
+inline auto load_execution_context_dispatch() -> void {
+	detail::execution_dispatch_storage = execution_context_dispatch{
+		.action = ecsact_system_execution_context_action,
+		.add = ecsact_system_execution_context_add,
+		.remove = ecsact_system_execution_context_remove,
+		.get = ecsact_system_execution_context_get,
+		.update = ecsact_system_execution_context_update,
+		.has = ecsact_system_execution_context_has,
+		.generate = ecsact_system_execution_context_generate,
+		.parent = ecsact_system_execution_context_parent,
+		.same = ecsact_system_execution_context_same,
+		.other = ecsact_system_execution_context_other,
+		.id = ecsact_system_execution_context_id,
+		.entity = ecsact_system_execution_context_entity,
+		.stream_toggle = ecsact_system_execution_context_stream_toggle,
+	};
+	detail::execution_dispatch_loaded.store(true, std::memory_order_release);
+}
+
+/**
+ * Loads the dispatch table the first time it is called. Called by the
+ * generated system implementation functions before running `impl`, since the
+ * runtime only provides its functions after the system module is loaded.
+ */
+inline auto ensure_execution_context_dispatch() -> void {
+	if(!detail::execution_dispatch_loaded.load(std::memory_order_acquire))
+		[[unlikely]] {
+		std::call_once(
+			detail::execution_dispatch_once,
+			load_execution_context_dispatch
+		);
+	}
+}
+
+} // namespace ecsact
+#endif
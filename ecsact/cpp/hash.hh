@@ -0,0 +1,110 @@
+#pragma once
+
+#include <bit>
+#include <ranges>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+namespace ecsact {
+
+/**
+ * Fast non-cryptographic 64-bit hash over a sequence of bytes. Consumes 8 bytes
+ * per step and finishes with an avalanche mix. Hashes are stable across runs
+ * and platforms of the same endianness, so they may be used for checksums
+ * (e.g. desync detection) but not for security.
+ */
+class hash_state {
+	static constexpr auto multiplier = std::uint64_t{0x9E3779B97F4A7C15ull};
+
+	std::uint64_t _state = 0x243F6A8885A308D3ull;
+
+	auto mix(std::uint64_t word) -> void {
+		_state = (std::rotl(_state, 5) ^ word) * multiplier;
+	}
+
+public:
+	auto append_bytes(const void* data, std::size_t size) -> void {
+		auto bytes = static_cast<const unsigned char*>(data);
+		while(size >= 8) {
+			auto word = std::uint64_t{};
+			std::memcpy(&word, bytes, 8);
+			mix(word);
+			bytes += 8;
+			size -= 8;
+		}
+
+		if(size > 0) {
+			auto word = std::uint64_t{};
+			std::memcpy(&word, bytes, size);
+			mix(word ^ (std::uint64_t{size} << 56));
+		}
+	}
+
+	template<typename T>
+	auto append(const T& value) -> void {
+		if constexpr(requires { value.hash_append(*this); }) {
+			value.hash_append(*this);
+		} else {
+			append_bytes(&value, sizeof(value));
+		}
+	}
+
+	auto finish() const -> std::uint64_t {
+		auto hash = _state;
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDull;
+		hash ^= hash >> 33;
+		hash *= 0xC4CEB9FE1A85EC53ull;
+		hash ^= hash >> 33;
+		return hash;
+	}
+};
+
+template<typename C>
+concept hashable = requires(const C& value, hash_state& state) {
+	value.hash_append(state);
+};
+
+/**
+ * Generated structs whose bytes contain no padding for the active layout mode.
+ */
+template<typename C>
+concept padding_free = requires { requires !C::has_padding; };
+
+template<hashable C>
+auto hash_value(const C& value) -> std::uint64_t {
+	auto state = hash_state{};
+	value.hash_append(state);
+	return state.finish();
+}
+
+/**
+ * Hashes every element of @p values in order. Accepts any contiguous range of
+ * hashable elements, e.g. `std::vector`, `std::array` or `std::span`.
+ * Generated structs without padding (`C::has_padding == false`) are hashed as
+ * one contiguous block of bytes.
+ */
+template<std::ranges::contiguous_range R>
+	requires(
+		std::ranges::sized_range<R> && hashable<std::ranges::range_value_t<R>>
+	)
+auto hash_range(const R& values) -> std::uint64_t {
+	using C = std::ranges::range_value_t<R>;
+
+	auto state = hash_state{};
+	if constexpr(padding_free<C>) {
+		state.append_bytes(
+			std::ranges::data(values),
+			std::ranges::size(values) * sizeof(C)
+		);
+	} else {
+		for(auto& value : values) {
+			value.hash_append(state);
+		}
+	}
+	return state.finish();
+}
+
+} // namespace ecsact
@@ -0,0 +1,798 @@
+#pragma once
+
+#include <span>
+#include <deque>
+#include <cassert>
+#include <chrono>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include "ecsact/runtime/dynamic.h"
+#include "ecsact/runtime/common.h"
+#include "ecsact/cpp/execution_context.hh"
+
+/**
+ * Minimal in-process implementation of the `ecsact_system_execution_context_*`
+ * functions for running generated system implementation functions without an
+ * Ecsact runtime, e.g. to benchmark system impls in isolation.
+ *
+ * Component data lives in one flat array per component, indexed by entity.
+ * The driver functions (`run_system`, `run_system_batch` and `run_action`)
+ * execute a system implementation function for every entity that has the
+ * given required components. Entities created with `generate` are added once
+ * the run completes.
+ *
+ * Not supported: assoc fields (association targets come from
+ * `world::resolve_other`), child systems, streaming and notify/lazy/parallel
+ * scheduling. Components must be registered with the world (creating entities
+ * with them does that) before systems read, add or generate them. Reading an
+ * unregistered component asserts.
+ *
+ * The runtime functions are provided in one of two ways:
+ *
+ * - Define ECSACT_CPP_MOCK_RUNTIME_IMPLEMENTATION in exactly one translation
+ *   unit before including this header to define them there.
+ * - With ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME call `ecsact::mock::install()`
+ *   before running any system to point the runtime function globals at the
+ *   mock. With ECSACT_CPP_EXECUTION_CONTEXT_DISPATCH that must happen before
+ *   the first system executes.
+ */
+namespace ecsact::mock {
+
+using system_fn = void (*)(ecsact_system_execution_context*);
+using batch_system_fn = void (*)(ecsact_system_execution_context**, int32_t);
+
+class world;
+
+namespace detail {
+/**
+ * The mock's execution context. Handed to system implementation functions as
+ * an `ecsact_system_execution_context*`.
+ */
+struct context {
+	mock::world*          world;
+	ecsact_system_like_id system_id;
+	std::size_t           entity_index;
+	const void*           action;
+	std::size_t           action_size;
+};
+
+inline auto to_context(ecsact_system_execution_context* ctx) -> context* {
+	return reinterpret_cast<context*>(ctx);
+}
+
+inline auto to_context(const ecsact_system_execution_context* ctx)
+	-> const context* {
+	return reinterpret_cast<const context*>(ctx);
+}
+
+inline auto to_c(context* ctx) -> ecsact_system_execution_context* {
+	return reinterpret_cast<ecsact_system_execution_context*>(ctx);
+}
+} // namespace detail
+
+class world {
+	struct component_storage {
+		ecsact_component_like_id  id;
+		std::size_t               size;
+		std::vector<std::byte>    data;
+		std::vector<std::uint8_t> present;
+	};
+
+	struct pending_entity {
+		std::vector<ecsact_component_id> ids;
+		std::vector<std::byte>           data;
+	};
+
+	std::size_t                    _entity_count = 0;
+	std::vector<component_storage> _storages;
+	/** Index into `_storages` by component id, -1 when not registered */
+	std::vector<std::int32_t>      _storage_index;
+	std::vector<pending_entity>    _pending_entities;
+	/** Contexts returned by `other()` during the current run */
+	std::deque<detail::context>    _other_contexts;
+
+	auto storage(ecsact_component_like_id id) -> component_storage* {
+		auto index = static_cast<std::size_t>(id);
+		if(index >= _storage_index.size() || _storage_index[index] < 0) {
+			return nullptr;
+		}
+		return &_storages[static_cast<std::size_t>(_storage_index[index])];
+	}
+
+	auto storage(ecsact_component_like_id id) const -> const component_storage* {
+		return const_cast<world*>(this)->storage(id);
+	}
+
+	auto add_entity_slots(std::size_t count) -> std::size_t {
+		auto first = _entity_count;
+		_entity_count += count;
+		for(auto& s : _storages) {
+			s.data.resize(_entity_count * s.size);
+			s.present.resize(_entity_count, 0);
+		}
+		return first;
+	}
+
+	auto set_component(
+		std::size_t              entity_index,
+		ecsact_component_like_id id,
+		const void*              data
+	) -> void {
+		auto s = storage(id);
+		if(s == nullptr) {
+			return;
+		}
+		if(s->size > 0 && data != nullptr) {
+			std::memcpy(s->data.data() + entity_index * s->size, data, s->size);
+		}
+		s->present[entity_index] = 1;
+	}
+
+	friend struct runtime_functions;
+
+public:
+	/**
+	 * Resolves the entity index `other()` returns a context for. Called with the
+	 * executing entity's index and the association id. When empty `other()`
+	 * returns `nullptr`.
+	 */
+	std::function<std::size_t(std::size_t, ecsact_system_assoc_id)>
+		resolve_other;
+
+	/**
+	 * Registers the storage for @p C. Safe to call more than once.
+	 */
+	template<typename C>
+	auto register_component() -> void {
+		auto id = ecsact_id_cast<ecsact_component_like_id>(C::id);
+		if(storage(id) != nullptr) {
+			return;
+		}
+
+		auto index = static_cast<std::size_t>(id);
+		if(index >= _storage_index.size()) {
+			_storage_index.resize(index + 1, -1);
+		}
+		_storage_index[index] = static_cast<std::int32_t>(_storages.size());
+
+		constexpr auto size = std::is_empty_v<C> ? 0 : sizeof(C);
+		_storages.push_back(component_storage{
+			.id = id,
+			.size = size,
+			.data = std::vector<std::byte>(_entity_count * size),
+			.present = std::vector<std::uint8_t>(_entity_count, 0),
+		});
+	}
+
+	/**
+	 * Creates @p count entities with a copy of @p components each. Returns the
+	 * index of the first new entity.
+	 */
+	template<typename... C>
+	auto create_entities(std::size_t count, const C&... components)
+		-> std::size_t {
+		(register_component<C>(), ...);
+		auto first = add_entity_slots(count);
+		for(auto i = first; _entity_count > i; ++i) {
+			(set_component(
+				 i,
+				 ecsact_id_cast<ecsact_component_like_id>(C::id),
+				 &components
+			 ),
+			 ...);
+		}
+		return first;
+	}
+
+	auto entity_count() const -> std::size_t {
+		return _entity_count;
+	}
+
+	template<typename C>
+	auto has(std::size_t entity_index) const -> bool {
+		auto s = storage(ecsact_id_cast<ecsact_component_like_id>(C::id));
+		return s != nullptr && s->present[entity_index] != 0;
+	}
+
+	/**
+	 * Reference to the component data of an entity. The entity must have @p C.
+	 */
+	template<typename C>
+		requires(!std::is_empty_v<C>)
+	auto get(std::size_t entity_index) -> C& {
+		auto s = storage(ecsact_id_cast<ecsact_component_like_id>(C::id));
+		assert(s != nullptr && "component not registered with the mock world");
+		return *reinterpret_cast<C*>(s->data.data() + entity_index * sizeof(C));
+	}
+
+	/**
+	 * `true` when the entity has every component in @p component_ids.
+	 */
+	auto matches(
+		std::size_t                               entity_index,
+		std::span<const ecsact_component_like_id> component_ids
+	) const -> bool {
+		return std::ranges::all_of(component_ids, [&](auto id) {
+			auto s = storage(id);
+			return s != nullptr && s->present[entity_index] != 0;
+		});
+	}
+
+	/**
+	 * Adds the entities generated since the last call. Called by the driver
+	 * functions once a run completes.
+	 */
+	auto apply_generated() -> void {
+		for(auto& pending : _pending_entities) {
+			auto index = add_entity_slots(1);
+			auto offset = std::size_t{0};
+			for(auto id : pending.ids) {
+				auto comp_id = ecsact_id_cast<ecsact_component_like_id>(id);
+				auto s = storage(comp_id);
+				set_component(index, comp_id, pending.data.data() + offset);
+				offset += s != nullptr ? s->size : 0;
+			}
+		}
+		_pending_entities.clear();
+		_other_contexts.clear();
+	}
+};
+
+/**
+ * Implementations of the `ecsact_system_execution_context_*` functions.
+ */
+struct runtime_functions {
+	static auto action(
+		ecsact_system_execution_context* ctx,
+		void*                            out_action_data
+	) -> void {
+		auto c = detail::to_context(ctx);
+		std::memcpy(out_action_data, c->action, c->action_size);
+	}
+
+	static auto add(
+		ecsact_system_execution_context* ctx,
+		ecsact_component_like_id         component_id,
+		const void*                      component_data
+	) -> void {
+		auto c = detail::to_context(ctx);
+		c->world->set_component(c->entity_index, component_id, component_data);
+	}
+
+	static auto remove(
+		ecsact_system_execution_context* ctx,
+		ecsact_component_like_id         component_id,
+		const void*
+	) -> void {
+		auto c = detail::to_context(ctx);
+		auto s = c->world->storage(component_id);
+		if(s != nullptr) {
+			s->present[c->entity_index] = 0;
+		}
+	}
+
+	static auto get(
+		ecsact_system_execution_context* ctx,
+		ecsact_component_like_id         component_id,
+		void*                            out_component_data,
+		const void*
+	) -> void {
+		auto  c = detail::to_context(ctx);
+		auto* s = c->world->storage(component_id);
+		assert(s != nullptr && "component not registered with the mock world");
+		std::memcpy(
+			out_component_data,
+			s->data.data() + c->entity_index * s->size,
+			s->size
+		);
+	}
+
+	static auto update(
+		ecsact_system_execution_context* ctx,
+		ecsact_component_like_id         component_id,
+		const void*                      component_data,
+		const void*
+	) -> void {
+		auto  c = detail::to_context(ctx);
+		auto* s = c->world->storage(component_id);
+		assert(s != nullptr && "component not registered with the mock world");
+		std::memcpy(
+			s->data.data() + c->entity_index * s->size,
+			component_data,
+			s->size
+		);
+	}
+
+	static auto has(
+		ecsact_system_execution_context* ctx,
+		ecsact_component_like_id         component_id,
+		const void*
+	) -> bool {
+		auto c = detail::to_context(ctx);
+		auto s = c->world->storage(component_id);
+		return s != nullptr && s->present[c->entity_index] != 0;
+	}
+
+	static auto generate(
+		ecsact_system_execution_context* ctx,
+		int                              component_count,
+		ecsact_component_id*             component_ids,
+		const void**                     components_data
+	) -> void {
+		auto  c = detail::to_context(ctx);
+		auto& pending = c->world->_pending_entities.emplace_back();
+		for(auto i = 0; component_count > i; ++i) {
+			auto comp_id = ecsact_id_cast<ecsact_component_like_id>(component_ids[i]);
+			auto s = c->world->storage(comp_id);
+			if(s == nullptr) {
+				continue;
+			}
+			auto bytes = static_cast<const std::byte*>(components_data[i]);
+			pending.ids.push_back(component_ids[i]);
+			pending.data.insert(pending.data.end(), bytes, bytes + s->size);
+		}
+	}
+
+	static auto parent(ecsact_system_execution_context*)
+		-> const ecsact_system_execution_context* {
+		return nullptr;
+	}
+
+	static auto same(
+		const ecsact_system_execution_context* a,
+		const ecsact_system_execution_context* b
+	) -> bool {
+		auto ca = detail::to_context(a);
+		auto cb = detail::to_context(b);
+		return ca->world == cb->world && ca->entity_index == cb->entity_index;
+	}
+
+	static auto other(
+		ecsact_system_execution_context* ctx,
+		ecsact_system_assoc_id           assoc_id
+	) -> ecsact_system_execution_context* {
+		auto c = detail::to_context(ctx);
+		if(!c->world->resolve_other) {
+			return nullptr;
+		}
+
+		auto& other_ctx = c->world->_other_contexts.emplace_back(*c);
+		other_ctx.entity_index = c->world->resolve_other(c->entity_index, assoc_id);
+		return detail::to_c(&other_ctx);
+	}
+
+	static auto id(ecsact_system_execution_context* ctx)
+		-> ecsact_system_like_id {
+		return detail::to_context(ctx)->system_id;
+	}
+
+	static auto entity(const ecsact_system_execution_context* ctx)
+		-> ecsact_entity_id {
+		return static_cast<ecsact_entity_id>(detail::to_context(ctx)->entity_index);
+	}
+
+	static auto stream_toggle(
+		ecsact_system_execution_context*,
+		ecsact_component_id,
+		bool,
+		const void*
+	) -> void {
+	}
+
+	static auto get_ptr(
+		ecsact_system_execution_context* ctx,
+		ecsact_component_like_id         component_id,
+		const void* const*
+	) -> const void* {
+		auto c = detail::to_context(ctx);
+		auto s = c->world->storage(component_id);
+		assert(s != nullptr && "component not registered with the mock world");
+		return s->data.data() + c->entity_index * s->size;
+	}
+
+	static auto action_ptr(ecsact_system_execution_context* ctx)
+		-> const void* {
+		return detail::to_context(ctx)->action;
+	}
+};
+
+#ifdef ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME
+/**
+ * Points the runtime function globals at the mock.
+ */
+inline auto install() -> void {
+#	define ECSACT_CPP_MOCK_INSTALL_(name) \
+		ecsact_system_execution_context_##name = &runtime_functions::name
+	ECSACT_CPP_MOCK_INSTALL_(action);
+	ECSACT_CPP_MOCK_INSTALL_(add);
+	ECSACT_CPP_MOCK_INSTALL_(remove);
+	ECSACT_CPP_MOCK_INSTALL_(get);
+	ECSACT_CPP_MOCK_INSTALL_(update);
+	ECSACT_CPP_MOCK_INSTALL_(has);
+	ECSACT_CPP_MOCK_INSTALL_(generate);
+	ECSACT_CPP_MOCK_INSTALL_(parent);
+	ECSACT_CPP_MOCK_INSTALL_(same);
+	ECSACT_CPP_MOCK_INSTALL_(other);
+	ECSACT_CPP_MOCK_INSTALL_(id);
+	ECSACT_CPP_MOCK_INSTALL_(entity);
+	ECSACT_CPP_MOCK_INSTALL_(stream_toggle);
+#	ifdef ECSACT_CPP_RUNTIME_GET_PTR
+	ECSACT_CPP_MOCK_INSTALL_(get_ptr);
+#	endif
+#	ifdef ECSACT_CPP_RUNTIME_ACTION_PTR
+	ECSACT_CPP_MOCK_INSTALL_(action_ptr);
+#	endif
+#	undef ECSACT_CPP_MOCK_INSTALL_
+}
+#endif
+
+/**
+ * Execution contexts of every entity that has a set of required components.
+ * Built once by `match_entities` and reused by the driver functions taking it,
+ * so benchmarks time the system executions only. Entities created or changed
+ * after matching are not picked up.
+ */
+struct matched_entities {
+	std::vector<detail::context>                  contexts;
+	std::vector<ecsact_system_execution_context*> context_ptrs;
+
+	auto size() const -> std::size_t {
+		return contexts.size();
+	}
+};
+
+/**
+ * Matches every entity of @p w that has all @p required components. @p action
+ * is the payload handed to action executions, `nullptr` for systems.
+ */
+inline auto match_entities(
+	world&                                    w,
+	ecsact_system_like_id                     system_id,
+	std::span<const ecsact_component_like_id> required,
+	const void*                               action = nullptr,
+	std::size_t                               action_size = 0
+) -> matched_entities {
+	auto matched = matched_entities{};
+	matched.contexts.reserve(w.entity_count());
+	for(auto i = std::size_t{0}; w.entity_count() > i; ++i) {
+		if(w.matches(i, required)) {
+			matched.contexts.push_back(detail::context{
+				.world = &w,
+				.system_id = system_id,
+				.entity_index = i,
+				.action = action,
+				.action_size = action_size,
+			});
+		}
+	}
+
+	matched.context_ptrs.reserve(matched.contexts.size());
+	for(auto& ctx : matched.contexts) {
+		matched.context_ptrs.push_back(detail::to_c(&ctx));
+	}
+	return matched;
+}
+
+/**
+ * Runs the system implementation function @p fn once for every entity in
+ * @p matched. Returns the number of executions.
+ */
+inline auto run_system(world& w, matched_entities& matched, system_fn fn)
+	-> std::size_t {
+	for(auto ctx : matched.context_ptrs) {
+		fn(ctx);
+	}
+	w.apply_generated();
+	return matched.size();
+}
+
+/**
+ * Like `run_system` but hands every entity in @p matched to the generated
+ * `<system>__batch` function @p fn in one call.
+ */
+inline auto run_system_batch(
+	world&            w,
+	matched_entities& matched,
+	batch_system_fn   fn
+) -> std::size_t {
+	fn(matched.context_ptrs.data(), static_cast<int32_t>(matched.size()));
+	w.apply_generated();
+	return matched.size();
+}
+
+/**
+ * Runs the system implementation function @p fn once for every entity that
+ * has all @p required components. Returns the number of executions.
+ */
+inline auto run_system(
+	world&                                    w,
+	ecsact_system_like_id                     system_id,
+	system_fn                                 fn,
+	std::span<const ecsact_component_like_id> required
+) -> std::size_t {
+	auto matched = match_entities(w, system_id, required);
+	return run_system(w, matched, fn);
+}
+
+/**
+ * Like `run_system` but hands every matching entity to the generated
+ * `<system>__batch` function @p fn in one call.
+ */
+inline auto run_system_batch(
+	world&                                    w,
+	ecsact_system_like_id                     system_id,
+	batch_system_fn                           fn,
+	std::span<const ecsact_component_like_id> required
+) -> std::size_t {
+	auto matched = match_entities(w, system_id, required);
+	return run_system_batch(w, matched, fn);
+}
+
+/**
+ * Runs the action implementation function @p fn with the payload @p action
+ * once for every entity that has all @p required components.
+ */
+template<typename A>
+auto run_action(
+	world&                                    w,
+	const A&                                  action,
+	system_fn                                 fn,
+	std::span<const ecsact_component_like_id> required
+) -> std::size_t {
+	auto matched = match_entities(
+		w,
+		ecsact_id_cast<ecsact_system_like_id>(A::id),
+		required,
+		&action,
+		sizeof(A)
+	);
+	return run_system(w, matched, fn);
+}
+
+/**
+ * `match_entities` for the system @p S with the components @p Required.
+ */
+template<typename S, typename... Required>
+auto match_entities(world& w) -> matched_entities {
+	const ecsact_component_like_id required[]{
+		ecsact_id_cast<ecsact_component_like_id>(Required::id)...,
+	};
+	return match_entities(
+		w,
+		ecsact_id_cast<ecsact_system_like_id>(S::id),
+		std::span{required, sizeof...(Required)}
+	);
+}
+
+/**
+ * `run_system` for the system @p S with the components @p Required, e.g.
+ * `run_system<example::Sys, pkg::A>(w, &example__Sys)`.
+ */
+template<typename S, typename... Required>
+auto run_system(world& w, system_fn fn) -> std::size_t {
+	const ecsact_component_like_id required[]{
+		ecsact_id_cast<ecsact_component_like_id>(Required::id)...,
+	};
+	return run_system(
+		w,
+		ecsact_id_cast<ecsact_system_like_id>(S::id),
+		fn,
+		std::span{required, sizeof...(Required)}
+	);
+}
+
+template<typename S, typename... Required>
+auto run_system_batch(world& w, batch_system_fn fn) -> std::size_t {
+	const ecsact_component_like_id required[]{
+		ecsact_id_cast<ecsact_component_like_id>(Required::id)...,
+	};
+	return run_system_batch(
+		w,
+		ecsact_id_cast<ecsact_system_like_id>(S::id),
+		fn,
+		std::span{required, sizeof...(Required)}
+	);
+}
+
+struct benchmark_result {
+	/** Executions of the system per run */
+	std::size_t              executions;
+	std::chrono::nanoseconds min;
+	std::chrono::nanoseconds median;
+
+	/** Median time per execution */
+	auto per_execution() const -> std::chrono::duration<double, std::nano> {
+		if(executions == 0) {
+			return {};
+		}
+		return std::chrono::duration<double, std::nano>{median} /
+			static_cast<double>(executions);
+	}
+};
+
+/**
+ * Calls @p run (which returns the number of executions, e.g. a lambda calling
+ * `run_system`) once to warm up and then @p iterations times, timing each
+ * call. The median is less sensitive to noise than the mean.
+ */
+template<typename Fn>
+auto benchmark(std::size_t iterations, Fn&& run) -> benchmark_result {
+	using clock = std::chrono::steady_clock;
+
+	auto result = benchmark_result{.executions = run()};
+	auto times = std::vector<std::chrono::nanoseconds>{};
+	times.reserve(iterations);
+	for(auto i = std::size_t{0}; iterations > i; ++i) {
+		auto start = clock::now();
+		run();
+		times.push_back(clock::now() - start);
+	}
+
+	if(!times.empty()) {
+		std::ranges::sort(times);
+		result.min = times.front();
+		result.median = times[times.size() / 2];
+	}
+	return result;
+}
+
+} // namespace ecsact::mock
+
+#ifdef ECSACT_CPP_MOCK_RUNTIME_IMPLEMENTATION
+#	ifdef ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME
+#		error "use ecsact::mock::install() with ECSACT_DYNAMIC_API_LOAD_AT_RUNTIME"
+#	endif
+
+ECSACT_EXTERN void ecsact_system_execution_context_action(
+	ecsact_system_execution_context* ctx,
+	void*                            out_action_data
+) {
+	ecsact::mock::runtime_functions::action(ctx, out_action_data);
+}
+
+ECSACT_EXTERN void ecsact_system_execution_context_add(
+	ecsact_system_execution_context* ctx,
+	ecsact_component_like_id         component_id,
+	const void*                      component_data
+) {
+	ecsact::mock::runtime_functions::add(ctx, component_id, component_data);
+}
+
+ECSACT_EXTERN void ecsact_system_execution_context_remove(
+	ecsact_system_execution_context* ctx,
+	ecsact_component_like_id         component_id,
+	const void*                      assoc_field_values
+) {
+	ecsact::mock::runtime_functions::remove(
+		ctx,
+		component_id,
+		assoc_field_values
+	);
+}
+
+ECSACT_EXTERN void ecsact_system_execution_context_get(
+	ecsact_system_execution_context* ctx,
+	ecsact_component_like_id         component_id,
+	void*                            out_component_data,
+	const void*                      assoc_field_values
+) {
+	ecsact::mock::runtime_functions::get(
+		ctx,
+		component_id,
+		out_component_data,
+		assoc_field_values
+	);
+}
+
+ECSACT_EXTERN void ecsact_system_execution_context_update(
+	ecsact_system_execution_context* ctx,
+	ecsact_component_like_id         component_id,
+	const void*                      component_data,
+	const void*                      assoc_field_values
+) {
+	ecsact::mock::runtime_functions::update(
+		ctx,
+		component_id,
+		component_data,
+		assoc_field_values
+	);
+}
+
+ECSACT_EXTERN bool ecsact_system_execution_context_has(
+	ecsact_system_execution_context* ctx,
+	ecsact_component_like_id         component_id,
+	const void*                      assoc_field_values
+) {
+	return ecsact::mock::runtime_functions::has(
+		ctx,
+		component_id,
+		assoc_field_values
+	);
+}
+
+ECSACT_EXTERN void ecsact_system_execution_context_generate(
+	ecsact_system_execution_context* ctx,
+	int                              component_count,
+	ecsact_component_id*             component_ids,
+	const void**                     components_data
+) {
+	ecsact::mock::runtime_functions::generate(
+		ctx,
+		component_count,
+		component_ids,
+		components_data
+	);
+}
+
+ECSACT_EXTERN const ecsact_system_execution_context*
+ecsact_system_execution_context_parent(ecsact_system_execution_context* ctx) {
+	return ecsact::mock::runtime_functions::parent(ctx);
+}
+
+ECSACT_EXTERN bool ecsact_system_execution_context_same(
+	const ecsact_system_execution_context* a,
+	const ecsact_system_execution_context* b
+) {
+	return ecsact::mock::runtime_functions::same(a, b);
+}
+
+ECSACT_EXTERN ecsact_system_execution_context*
+ecsact_system_execution_context_other(
+	ecsact_system_execution_context* ctx,
+	ecsact_system_assoc_id           assoc_id
+) {
+	return ecsact::mock::runtime_functions::other(ctx, assoc_id);
+}
+
+ECSACT_EXTERN ecsact_system_like_id
+ecsact_system_execution_context_id(ecsact_system_execution_context* ctx) {
+	return ecsact::mock::runtime_functions::id(ctx);
+}
+
+ECSACT_EXTERN ecsact_entity_id ecsact_system_execution_context_entity(
+	const ecsact_system_execution_context* ctx
+) {
+	return ecsact::mock::runtime_functions::entity(ctx);
+}
+
+ECSACT_EXTERN void ecsact_system_execution_context_stream_toggle(
+	ecsact_system_execution_context* ctx,
+	ecsact_component_id              component_id,
+	bool                             enable_stream_data,
+	const void*                      assoc_field_values
+) {
+	ecsact::mock::runtime_functions::stream_toggle(
+		ctx,
+		component_id,
+		enable_stream_data,
+		assoc_field_values
+	);
+}
+
+#	ifdef ECSACT_CPP_RUNTIME_GET_PTR
+ECSACT_EXTERN const void* ecsact_system_execution_context_get_ptr(
+	struct ecsact_system_execution_context* ctx,
+	ecsact_component_like_id                component_id,
+	const void* const*                      assoc_field_values
+) {
+	return ecsact::mock::runtime_functions::get_ptr(
+		ctx,
+		component_id,
+		assoc_field_values
+	);
+}
+#	endif
+
+#	ifdef ECSACT_CPP_RUNTIME_ACTION_PTR
+ECSACT_EXTERN const void* ecsact_system_execution_context_action_ptr(
+	struct ecsact_system_execution_context* ctx
+) {
+	return ecsact::mock::runtime_functions::action_ptr(ctx);
+}
+#	endif
+#endif
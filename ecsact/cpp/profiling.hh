@@ -0,0 +1,359 @@
+#pragma once
+
+#include <bit>
+#include <map>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include "ecsact/runtime/common.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#	else
+#		include <x86intrin.h>
+#	endif
+#	define ECSACT_CPP_PROFILING_TSC
+#endif
+
+/**
+ * Per-system timing used by the generated system implementation functions when
+ * ECSACT_CPP_SYSTEM_PROFILING is defined.
+ *
+ * Each `scope` takes one timestamp (TSC on x86-64, `std::chrono::steady_clock`
+ * elsewhere) on entry and exit and writes a sample into a ring buffer owned by
+ * the calling thread. Writing never locks or allocates. `collect()` drains the
+ * buffers of every thread into aggregated per-system statistics and may be
+ * called from any thread. Samples are dropped (and counted) when a thread
+ * writes more than `ring_capacity` samples between two collections.
+ */
+namespace ecsact::profiling {
+
+using ticks = std::uint64_t;
+
+inline auto now() -> ticks {
+#ifdef ECSACT_CPP_PROFILING_TSC
+	return __rdtsc();
+#else
+	return static_cast<ticks>(
+		std::chrono::steady_clock::now().time_since_epoch().count()
+	);
+#endif
+}
+
+/**
+ * Number of `now()` ticks per second. Measured against `steady_clock` on the
+ * first call when using the TSC.
+ */
+inline auto ticks_per_second() -> double {
+#ifdef ECSACT_CPP_PROFILING_TSC
+	static const auto value = [] {
+		using namespace std::chrono;
+		auto clock_start = steady_clock::now();
+		auto tsc_start = now();
+		while(steady_clock::now() - clock_start < milliseconds{10}) {
+		}
+		auto clock_end = steady_clock::now();
+		auto tsc_end = now();
+		auto elapsed = duration<double>(clock_end - clock_start).count();
+		return static_cast<double>(tsc_end - tsc_start) / elapsed;
+	}();
+	return value;
+#else
+	using period = std::chrono::steady_clock::period;
+	return static_cast<double>(period::den) / static_cast<double>(period::num);
+#endif
+}
+
+inline auto to_duration(ticks t) -> std::chrono::nanoseconds {
+	return std::chrono::nanoseconds{static_cast<std::int64_t>(
+		static_cast<double>(t) * 1'000'000'000.0 / ticks_per_second()
+	)};
+}
+
+struct sample {
+	ecsact_system_like_id system_id;
+	std::int32_t          entity_count;
+	ticks                 start;
+	ticks                 duration;
+};
+
+/**
+ * Single producer, single consumer ring of trivially copyable @p T. Written by
+ * the owning thread and read by a collector. Slots are stored as relaxed atomic
+ * words so a reader racing with the writer only ever sees torn values, which
+ * are detected by checking the write position again after reading and
+ * discarded.
+ */
+template<typename T, std::size_t Capacity>
+class spsc_ring {
+	static_assert(std::is_trivially_copyable_v<T>);
+
+	static constexpr auto slot_words =
+		(sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+	using slot = std::array<std::atomic<std::uint64_t>, slot_words>;
+
+	std::array<slot, Capacity> _slots;
+	std::atomic<std::uint64_t> _written = 0;
+	std::uint64_t              _read = 0;
+
+public:
+	auto push(const T& value) -> void {
+		std::uint64_t words[slot_words]{};
+		std::memcpy(words, &value, sizeof(T));
+
+		auto index = _written.load(std::memory_order_relaxed);
+		// orders the previous `_written` store before the slot stores below so a
+		// reader that sees any of them also sees the write position
+		std::atomic_thread_fence(std::memory_order_release);
+		auto& slot = _slots[index % Capacity];
+		for(auto i = std::size_t{0}; slot_words > i; ++i) {
+			slot[i].store(words[i], std::memory_order_relaxed);
+		}
+		_written.store(index + 1, std::memory_order_release);
+	}
+
+	/**
+	 * Calls @p fn for every value written since the last drain. Returns the
+	 * number of values that were overwritten before they could be read.
+	 */
+	template<typename Fn>
+	auto drain(Fn&& fn) -> std::uint64_t {
+		auto written = _written.load(std::memory_order_acquire);
+		auto dropped = std::uint64_t{0};
+		if(written - _read > Capacity) {
+			dropped += written - _read - Capacity;
+			_read = written - Capacity;
+		}
+
+		for(; written > _read; ++_read) {
+			auto& slot = _slots[_read % Capacity];
+			std::uint64_t words[slot_words];
+			for(auto i = std::size_t{0}; slot_words > i; ++i) {
+				words[i] = slot[i].load(std::memory_order_relaxed);
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if(_written.load(std::memory_order_relaxed) - _read >= Capacity) {
+				// the writer may have overwritten this slot while we read it
+				dropped += 1;
+				continue;
+			}
+
+			auto value = T{};
+			std::memcpy(&value, words, sizeof(T));
+			fn(value);
+		}
+
+		return dropped;
+	}
+};
+
+inline constexpr auto ring_capacity = std::size_t{8192};
+
+/**
+ * Samples of one thread, read by `collect()`.
+ */
+using ring_buffer = spsc_ring<sample, ring_capacity>;
+
+namespace detail {
+struct ring_registry {
+	std::mutex                               mutex;
+	std::deque<std::unique_ptr<ring_buffer>> rings;
+};
+
+inline auto rings() -> ring_registry& {
+	static auto registry = ring_registry{};
+	return registry;
+}
+
+inline auto thread_ring() -> ring_buffer& {
+	thread_local auto ring = [] {
+		auto& registry = rings();
+		auto  lk = std::scoped_lock{registry.mutex};
+		return registry.rings.emplace_back(std::make_unique<ring_buffer>()).get();
+	}();
+	return *ring;
+}
+} // namespace detail
+
+/**
+ * Records one sample for @p system_id covering the lifetime of the scope.
+ */
+class scope {
+	ecsact_system_like_id _system_id;
+	std::int32_t          _entity_count;
+	ticks                 _start;
+
+public:
+	scope(ecsact_system_like_id system_id, std::int32_t entity_count)
+		: _system_id(system_id), _entity_count(entity_count), _start(now()) {
+	}
+
+	scope(const scope&) = delete;
+	scope(scope&&) = delete;
+
+	~scope() {
+		auto end = now();
+		detail::thread_ring().push(sample{
+			.system_id = _system_id,
+			.entity_count = _entity_count,
+			.start = _start,
+			.duration = end - _start,
+		});
+	}
+};
+
+/**
+ * Log-linear histogram of durations in ticks. Each power of two is split into
+ * `sub_buckets` buckets, giving percentiles within ~12% of the real value.
+ */
+class histogram {
+	static constexpr auto sub_bucket_bits = 3;
+	static constexpr auto sub_buckets = 1 << sub_bucket_bits;
+
+	std::array<std::uint64_t, 64 * sub_buckets> _counts{};
+	std::uint64_t                               _total = 0;
+
+	static auto bucket_index(ticks t) -> std::size_t {
+		if(t < sub_buckets) {
+			return static_cast<std::size_t>(t);
+		}
+		auto msb = 63 - std::countl_zero(t);
+		auto sub = (t >> (msb - sub_bucket_bits)) & (sub_buckets - 1);
+		return static_cast<std::size_t>(
+			(msb - sub_bucket_bits + 1) * sub_buckets + sub
+		);
+	}
+
+	static auto bucket_upper_bound(std::size_t index) -> ticks {
+		if(index < sub_buckets) {
+			return index;
+		}
+		auto exponent = index / sub_buckets + sub_bucket_bits - 1;
+		auto sub = index % sub_buckets;
+		return ((ticks{sub_buckets} + sub + 1) << (exponent - sub_bucket_bits)) - 1;
+	}
+
+public:
+	auto add(ticks t) -> void {
+		_counts[bucket_index(t)] += 1;
+		_total += 1;
+	}
+
+	/**
+	 * Upper bound of the bucket containing the @p p quantile (0.0 - 1.0), using
+	 * the nearest rank `ceil(p * total)`.
+	 */
+	auto percentile(double p) const -> ticks {
+		if(_total == 0) {
+			return 0;
+		}
+		auto total = static_cast<double>(_total);
+		auto rank =
+			static_cast<std::uint64_t>(std::clamp(std::ceil(p * total), 1.0, total));
+		auto seen = std::uint64_t{0};
+		for(auto i = std::size_t{0}; _counts.size() > i; ++i) {
+			seen += _counts[i];
+			if(seen >= rank) {
+				return bucket_upper_bound(i);
+			}
+		}
+		return bucket_upper_bound(_counts.size() - 1);
+	}
+};
+
+struct system_stats {
+	std::uint64_t call_count = 0;
+	std::uint64_t entity_count = 0;
+	ticks         total = 0;
+	ticks         min = ~ticks{0};
+	ticks         max = 0;
+	histogram     durations;
+
+	auto add(const sample& s) -> void {
+		call_count += 1;
+		entity_count += static_cast<std::uint64_t>(s.entity_count);
+		total += s.duration;
+		min = std::min(min, s.duration);
+		max = std::max(max, s.duration);
+		durations.add(s.duration);
+	}
+
+	auto total_time() const -> std::chrono::nanoseconds {
+		return to_duration(total);
+	}
+
+	auto min_time() const -> std::chrono::nanoseconds {
+		return to_duration(call_count > 0 ? min : 0);
+	}
+
+	auto max_time() const -> std::chrono::nanoseconds {
+		return to_duration(max);
+	}
+
+	auto percentile_time(double p) const -> std::chrono::nanoseconds {
+		return to_duration(durations.percentile(p));
+	}
+};
+
+struct report {
+	std::map<ecsact_system_like_id, system_stats> systems;
+	/** Samples lost because a thread's ring buffer was full */
+	std::uint64_t dropped_samples = 0;
+};
+
+namespace detail {
+struct aggregate_state {
+	std::mutex mutex;
+	report     totals;
+};
+
+inline auto aggregate() -> aggregate_state& {
+	static auto state = aggregate_state{};
+	return state;
+}
+} // namespace detail
+
+/**
+ * Drains the samples of every thread and returns the statistics accumulated
+ * since the last `reset()`.
+ */
+inline auto collect() -> report {
+	auto& state = detail::aggregate();
+	auto& registry = detail::rings();
+	auto  lk = std::scoped_lock{state.mutex, registry.mutex};
+
+	for(auto& ring : registry.rings) {
+		state.totals.dropped_samples += ring->drain([&](const sample& s) {
+			state.totals.systems[s.system_id].add(s);
+		});
+	}
+
+	return state.totals;
+}
+
+/**
+ * Discards all statistics and pending samples.
+ */
+inline auto reset() -> void {
+	auto& state = detail::aggregate();
+	auto& registry = detail::rings();
+	auto  lk = std::scoped_lock{state.mutex, registry.mutex};
+
+	for(auto& ring : registry.rings) {
+		ring->drain([](const sample&) {});
+	}
+	state.totals = report{};
+}
+
+} // namespace ecsact::profiling
@@ -0,0 +1,463 @@
+#pragma once
+
+#include "ecsact/runtime/common.h"
+
+/**
+ * Hooks called by `ecsact::execution_context` after each runtime call. They
+ * expand to nothing unless ECSACT_CPP_REDUNDANT_ACCESS_CHECK is defined.
+ */
+#ifdef ECSACT_CPP_REDUNDANT_ACCESS_CHECK
+#	define ECSACT_CPP_TRACK_GET(ctx, component) \
+		::ecsact::redundant_access::detail::on_get(ctx, component)
+#	define ECSACT_CPP_TRACK_UPDATE(ctx, component) \
+		::ecsact::redundant_access::detail::on_update(ctx, component)
+#	define ECSACT_CPP_TRACK_HAS(ctx, component_id, result)      \
+		::ecsact::redundant_access::detail::on_has(               \
+			ctx,                                                    \
+			ecsact_id_cast<ecsact_component_like_id>(component_id), \
+			result                                                  \
+		)
+#	define ECSACT_CPP_TRACK_OTHER(ctx, assoc_id) \
+		::ecsact::redundant_access::detail::on_other(ctx, assoc_id)
+#else
+#	define ECSACT_CPP_TRACK_GET(ctx, component)
+#	define ECSACT_CPP_TRACK_UPDATE(ctx, component)
+#	define ECSACT_CPP_TRACK_HAS(ctx, component_id, result)
+#	define ECSACT_CPP_TRACK_OTHER(ctx, assoc_id)
+#endif
+
+#ifdef ECSACT_CPP_REDUNDANT_ACCESS_CHECK
+#	include <map>
+#	include <deque>
+#	include <mutex>
+#	include <memory>
+#	include <vector>
+#	include <cstdio>
+#	include <cstdlib>
+#	include <cstddef>
+#	include <cstdint>
+#	include <cstring>
+
+struct ecsact_system_execution_context;
+
+/**
+ * Debug mode that finds execution context calls wasting time in system impls,
+ * used when ECSACT_CPP_REDUNDANT_ACCESS_CHECK is defined. The generated system
+ * implementation functions open a `scope` around every `impl` call. Within one
+ * call it detects:
+ *
+ * - `get<C>()` of a component that was already read (or written) in the call
+ * - `update<C>()` with the value that was last read or written
+ * - `has<C>()` returning `true` followed by `get<C>()`. Whether the `get` was
+ *   conditional can't be observed, but when `has` never returned `false` for
+ *   a system (`has_false` is 0) the check is wasted
+ * - `other<N>()` called more than once for the same association
+ *
+ * Accesses with assoc fields are not tracked. Findings are aggregated per
+ * system and component across all threads and printed to `stderr` at exit.
+ * `collect()` returns them at any time and `print_report()` prints them.
+ */
+namespace ecsact::redundant_access {
+
+struct component_findings {
+	std::uint64_t repeated_get = 0;
+	std::uint64_t identical_update = 0;
+	std::uint64_t has_then_get = 0;
+	/** Number of `has<C>()` calls that returned `false` */
+	std::uint64_t has_false = 0;
+
+	auto operator+=(const component_findings& other) -> component_findings& {
+		repeated_get += other.repeated_get;
+		identical_update += other.identical_update;
+		has_then_get += other.has_then_get;
+		has_false += other.has_false;
+		return *this;
+	}
+
+	/** `true` when nothing redundant was found. Ignores `has_false`. */
+	auto empty() const -> bool {
+		return repeated_get == 0 && identical_update == 0 && has_then_get == 0;
+	}
+};
+
+struct system_findings {
+	/** Full name of the system, a static string */
+	const char*   name = nullptr;
+	std::uint64_t calls = 0;
+
+	std::map<ecsact_component_like_id, component_findings> components;
+	/** Number of repeated `other<N>()` calls per association */
+	std::map<ecsact_system_assoc_id, std::uint64_t> repeated_other;
+
+	auto empty() const -> bool {
+		for(auto&& [_, findings] : components) {
+			if(!findings.empty()) {
+				return false;
+			}
+		}
+		return repeated_other.empty();
+	}
+};
+
+struct report {
+	std::map<ecsact_system_like_id, system_findings> systems;
+};
+
+namespace detail {
+enum class access_kind : std::uint8_t {
+	component,
+	other,
+};
+
+/**
+ * Accesses of one component (or one association) through one execution
+ * context during an `impl` call.
+ */
+struct tracked_access {
+	ecsact_system_execution_context* ctx;
+	access_kind                      kind;
+	std::int32_t                     id;
+	std::uint32_t                    access_count = 0;
+	bool                             has_true = false;
+	/** Offset of the last read or written value in `call_state::values` */
+	std::size_t                      value_offset = 0;
+	std::size_t                      value_size = 0;
+	component_findings               findings = {};
+};
+
+struct call_state {
+	ecsact_system_like_id       system_id;
+	const char*                 system_name;
+	std::vector<tracked_access> accesses;
+	std::vector<std::byte>      values;
+
+	auto find(
+		ecsact_system_execution_context* ctx,
+		access_kind                      kind,
+		std::int32_t                     id
+	) -> tracked_access& {
+		for(auto& access : accesses) {
+			if(access.ctx == ctx && access.kind == kind && access.id == id) {
+				return access;
+			}
+		}
+		return accesses.emplace_back(tracked_access{
+			.ctx = ctx,
+			.kind = kind,
+			.id = id,
+		});
+	}
+
+	auto store_value(tracked_access& access, const void* data, std::size_t size)
+		-> void {
+		if(access.value_size == 0) {
+			access.value_offset = values.size();
+			access.value_size = size;
+			values.resize(values.size() + size);
+		}
+		std::memcpy(values.data() + access.value_offset, data, size);
+	}
+};
+
+/**
+ * Findings of one thread, merged into a `report` by `collect()`.
+ */
+struct thread_table {
+	std::mutex mutex;
+	report     findings;
+};
+
+struct state {
+	std::mutex                                mutex;
+	std::deque<std::unique_ptr<thread_table>> tables;
+};
+
+/**
+ * Intentionally leaked so the exit report and threads still running during
+ * static destruction never see a destroyed state.
+ */
+inline auto global_state() -> state& {
+	static auto s = new state{};
+	return *s;
+}
+
+inline auto print_exit_report() -> void;
+
+/**
+ * `impl` calls running on this thread. Nested calls (e.g. a system running
+ * another system's trampoline) get their own entry.
+ */
+struct thread_state {
+	std::vector<call_state> calls;
+	std::size_t             depth = 0;
+	thread_table*           table = nullptr;
+};
+
+inline auto this_thread() -> thread_state& {
+	thread_local auto t = thread_state{};
+	return t;
+}
+
+inline auto current_call() -> call_state* {
+	auto& t = this_thread();
+	if(t.depth == 0) {
+		return nullptr;
+	}
+	return &t.calls[t.depth - 1];
+}
+
+template<typename C>
+auto same_value(const C& value, const std::byte* stored) -> bool {
+	auto stored_value = C{};
+	std::memcpy(&stored_value, stored, sizeof(C));
+	if constexpr(requires { C::bitwise_equal(value, stored_value); }) {
+		return C::bitwise_equal(value, stored_value);
+	} else {
+		return std::memcmp(&value, stored, sizeof(C)) == 0;
+	}
+}
+
+template<typename C>
+auto on_get(ecsact_system_execution_context* ctx, const C& component) -> void {
+	auto call = current_call();
+	if(call == nullptr) {
+		return;
+	}
+
+	auto& access = call->find(
+		ctx,
+		access_kind::component,
+		static_cast<std::int32_t>(C::id)
+	);
+	if(access.value_size > 0) {
+		access.findings.repeated_get += 1;
+	}
+	if(access.has_true) {
+		access.findings.has_then_get += 1;
+		access.has_true = false;
+	}
+	access.access_count += 1;
+	call->store_value(access, &component, sizeof(C));
+}
+
+template<typename C>
+auto on_update(ecsact_system_execution_context* ctx, const C& component)
+	-> void {
+	auto call = current_call();
+	if(call == nullptr) {
+		return;
+	}
+
+	auto& access = call->find(
+		ctx,
+		access_kind::component,
+		static_cast<std::int32_t>(C::id)
+	);
+	if(access.value_size > 0 &&
+		 same_value(component, call->values.data() + access.value_offset)) {
+		access.findings.identical_update += 1;
+	}
+	access.access_count += 1;
+	call->store_value(access, &component, sizeof(C));
+}
+
+inline auto on_has(
+	ecsact_system_execution_context* ctx,
+	ecsact_component_like_id         component_id,
+	bool                             result
+) -> void {
+	auto call = current_call();
+	if(call == nullptr) {
+		return;
+	}
+
+	auto& access = call->find(
+		ctx,
+		access_kind::component,
+		static_cast<std::int32_t>(component_id)
+	);
+	access.has_true = result;
+	if(!result) {
+		access.findings.has_false += 1;
+	}
+}
+
+inline auto on_other(
+	ecsact_system_execution_context* ctx,
+	ecsact_system_assoc_id           assoc_id
+) -> void {
+	auto call = current_call();
+	if(call == nullptr) {
+		return;
+	}
+
+	auto& access =
+		call->find(ctx, access_kind::other, static_cast<std::int32_t>(assoc_id));
+	access.access_count += 1;
+}
+
+/**
+ * Merges the findings of every thread. Must be called with `s.mutex` held.
+ */
+inline auto merge_tables(state& s) -> report {
+	auto result = report{};
+	for(auto& table : s.tables) {
+		auto table_lk = std::scoped_lock{table->mutex};
+		for(auto&& [sys_id, findings] : table->findings.systems) {
+			auto& sys = result.systems[sys_id];
+			sys.name = findings.name;
+			sys.calls += findings.calls;
+			for(auto&& [comp_id, comp_findings] : findings.components) {
+				sys.components[comp_id] += comp_findings;
+			}
+			for(auto&& [assoc_id, count] : findings.repeated_other) {
+				sys.repeated_other[assoc_id] += count;
+			}
+		}
+	}
+	return result;
+}
+
+/**
+ * Adds the findings of a finished `impl` call to the thread's table.
+ */
+inline auto finish_call(thread_state& t, call_state& call) -> void {
+	if(t.table == nullptr) {
+		auto& s = global_state();
+		auto  lk = std::scoped_lock{s.mutex};
+		if(s.tables.empty()) {
+			std::atexit(print_exit_report);
+		}
+		t.table = s.tables.emplace_back(std::make_unique<thread_table>()).get();
+	}
+
+	auto  lk = std::scoped_lock{t.table->mutex};
+	auto& sys = t.table->findings.systems[call.system_id];
+	sys.name = call.system_name;
+	sys.calls += 1;
+
+	for(auto& access : call.accesses) {
+		if(access.kind == access_kind::other) {
+			if(access.access_count > 1) {
+				auto assoc_id = static_cast<ecsact_system_assoc_id>(access.id);
+				sys.repeated_other[assoc_id] += access.access_count - 1;
+			}
+		} else if(!access.findings.empty() || access.findings.has_false > 0) {
+			auto comp_id = static_cast<ecsact_component_like_id>(access.id);
+			sys.components[comp_id] += access.findings;
+		}
+	}
+}
+} // namespace detail
+
+/**
+ * Tracks the execution context calls of one system `impl` call. Opened by the
+ * generated system implementation functions.
+ */
+class scope {
+public:
+	scope(ecsact_system_like_id system_id, const char* system_name) {
+		auto& t = detail::this_thread();
+		if(t.calls.size() == t.depth) {
+			t.calls.emplace_back();
+		}
+
+		auto& call = t.calls[t.depth];
+		call.system_id = system_id;
+		call.system_name = system_name;
+		call.accesses.clear();
+		call.values.clear();
+		t.depth += 1;
+	}
+
+	scope(const scope&) = delete;
+	scope(scope&&) = delete;
+
+	~scope() {
+		auto& t = detail::this_thread();
+		t.depth -= 1;
+		detail::finish_call(t, t.calls[t.depth]);
+	}
+};
+
+/**
+ * Merges the findings of every thread. Systems without findings are included
+ * with their call count.
+ */
+inline auto collect() -> report {
+	auto& s = detail::global_state();
+	auto  lk = std::scoped_lock{s.mutex};
+	return detail::merge_tables(s);
+}
+
+/**
+ * Discards all findings.
+ */
+inline auto reset() -> void {
+	auto& s = detail::global_state();
+	auto  lk = std::scoped_lock{s.mutex};
+	for(auto& table : s.tables) {
+		auto table_lk = std::scoped_lock{table->mutex};
+		table->findings = report{};
+	}
+}
+
+/**
+ * Writes the systems with findings in @p r to @p out in a human readable form,
+ * e.g. `print_report(collect())`.
+ */
+inline auto print_report(const report& r, std::FILE* out = stderr) -> void {
+	auto any = false;
+	for(auto&& [sys_id, sys] : r.systems) {
+		if(sys.empty()) {
+			continue;
+		}
+
+		if(!any) {
+			std::fputs("ecsact redundant access report\n", out);
+			any = true;
+		}
+
+		std::fprintf(
+			out,
+			"  %s (system %i, %llu calls)\n",
+			sys.name != nullptr ? sys.name : "<unknown>",
+			static_cast<int>(sys_id),
+			static_cast<unsigned long long>(sys.calls)
+		);
+		for(auto&& [comp_id, findings] : sys.components) {
+			if(findings.empty()) {
+				continue;
+			}
+			std::fprintf(
+				out,
+				"    component %i: %llu repeated get, %llu identical update, "
+				"%llu has then get (has was false %llu times)\n",
+				static_cast<int>(comp_id),
+				static_cast<unsigned long long>(findings.repeated_get),
+				static_cast<unsigned long long>(findings.identical_update),
+				static_cast<unsigned long long>(findings.has_then_get),
+				static_cast<unsigned long long>(findings.has_false)
+			);
+		}
+		for(auto&& [assoc_id, count] : sys.repeated_other) {
+			std::fprintf(
+				out,
+				"    association %i: %llu repeated other\n",
+				static_cast<int>(assoc_id),
+				static_cast<unsigned long long>(count)
+			);
+		}
+	}
+}
+
+/**
+ * Prints the report of the whole process at exit. Registered with `std::atexit`
+ * when the first `impl` call finishes.
+ */
+inline auto detail::print_exit_report() -> void {
+	print_report(collect());
+}
+
+} // namespace ecsact::redundant_access
+#endif
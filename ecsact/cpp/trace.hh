@@ -0,0 +1,253 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <cstdio>
+#include <cstdint>
+#include <condition_variable>
+#include "ecsact/cpp/profiling.hh"
+
+/**
+ * System execution tracing in the Chrome trace event format, used by the
+ * generated system implementation functions when ECSACT_CPP_SYSTEM_TRACE is
+ * defined. The resulting file can be opened with Perfetto
+ * (https://ui.perfetto.dev) or chrome://tracing.
+ *
+ * Spans are only recorded between `start()` and `stop()`. Each span is written
+ * into a fixed size ring buffer owned by the calling thread; a background
+ * thread drains the rings and appends the events to the trace file. Memory use
+ * is bounded by the ring size per thread. Spans are dropped (and counted) when
+ * a thread records more than `ring_capacity` spans between two drains.
+ *
+ * `stop()` must be called before the process exits while a trace is running.
+ */
+namespace ecsact::trace {
+
+struct event {
+	/** Static string, e.g. the system full name */
+	const char*      name;
+	/** Static string or `nullptr` */
+	const char*      parent;
+	std::int32_t     entity_count;
+	profiling::ticks start;
+	profiling::ticks duration;
+};
+
+inline constexpr auto ring_capacity = std::size_t{4096};
+
+/**
+ * Events of one thread, drained by the background writer.
+ */
+class ring_buffer : public profiling::spsc_ring<event, ring_capacity> {
+public:
+	const std::uint32_t thread_index;
+
+	explicit ring_buffer(std::uint32_t thread_index)
+		: thread_index(thread_index) {
+	}
+};
+
+namespace detail {
+struct trace_state {
+	std::atomic_bool enabled = false;
+
+	std::mutex                               rings_mutex;
+	std::deque<std::unique_ptr<ring_buffer>> rings;
+
+	std::mutex              writer_mutex;
+	std::condition_variable writer_cv;
+	std::thread             writer;
+	bool                    stopping = false;
+	std::FILE*              file = nullptr;
+	bool                    first_event = true;
+	profiling::ticks        start_ticks = 0;
+	std::uint64_t           dropped = 0;
+};
+
+inline auto state() -> trace_state& {
+	static auto s = trace_state{};
+	return s;
+}
+
+inline auto thread_ring() -> ring_buffer& {
+	thread_local auto ring = [] {
+		auto& s = state();
+		auto  lk = std::scoped_lock{s.rings_mutex};
+		auto  thread_index = static_cast<std::uint32_t>(s.rings.size() + 1);
+		return s.rings.emplace_back(std::make_unique<ring_buffer>(thread_index))
+			.get();
+	}();
+	return *ring;
+}
+
+inline auto to_micros(profiling::ticks t) -> double {
+	return static_cast<double>(t) * 1'000'000.0 / profiling::ticks_per_second();
+}
+
+/**
+ * Appends every pending event to the trace file. Called by the writer thread
+ * and by `stop()` with `writer_mutex` held.
+ */
+inline auto write_pending(trace_state& s, std::string& buffer) -> void {
+	auto lk = std::scoped_lock{s.rings_mutex};
+	for(auto& ring : s.rings) {
+		s.dropped += ring->drain([&](const event& e) {
+			if(e.start < s.start_ticks) {
+				// started before this trace
+				return;
+			}
+
+			buffer += s.first_event ? "\n" : ",\n";
+			s.first_event = false;
+
+			char fields[160];
+			std::snprintf(
+				fields,
+				sizeof(fields),
+				"\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,",
+				ring->thread_index,
+				to_micros(e.start - s.start_ticks),
+				to_micros(e.duration)
+			);
+
+			buffer += "{\"name\":\"";
+			buffer += e.name;
+			buffer += "\",\"cat\":\"system\",";
+			buffer += fields;
+			buffer += "\"args\":{\"entities\":";
+			buffer += std::to_string(e.entity_count);
+			if(e.parent != nullptr) {
+				buffer += ",\"parent\":\"";
+				buffer += e.parent;
+				buffer += "\"";
+			}
+			buffer += "}}";
+		});
+	}
+
+	if(!buffer.empty()) {
+		std::fwrite(buffer.data(), 1, buffer.size(), s.file);
+		buffer.clear();
+	}
+}
+} // namespace detail
+
+/**
+ * Starts tracing into a new file at @p path. The background writer appends
+ * recorded spans to the file every @p flush_interval. Returns `false` if
+ * tracing is already running or the file could not be opened.
+ */
+inline auto start(
+	const char*               path,
+	std::chrono::milliseconds flush_interval = std::chrono::milliseconds{50}
+) -> bool {
+	auto& s = detail::state();
+	auto  lk = std::unique_lock{s.writer_mutex};
+	if(s.file != nullptr) {
+		return false;
+	}
+
+	s.file = std::fopen(path, "wb");
+	if(s.file == nullptr) {
+		return false;
+	}
+
+	std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", s.file);
+	s.first_event = true;
+	s.stopping = false;
+	s.dropped = 0;
+	s.start_ticks = profiling::now();
+
+	// discard spans recorded by a previous trace
+	{
+		auto rings_lk = std::scoped_lock{s.rings_mutex};
+		for(auto& ring : s.rings) {
+			ring->drain([](const event&) {});
+		}
+	}
+
+	s.writer = std::thread([&s, flush_interval] {
+		auto buffer = std::string{};
+		auto lk = std::unique_lock{s.writer_mutex};
+		while(!s.stopping) {
+			s.writer_cv.wait_for(lk, flush_interval, [&] { return s.stopping; });
+			detail::write_pending(s, buffer);
+		}
+	});
+
+	s.enabled.store(true, std::memory_order_release);
+	return true;
+}
+
+/**
+ * Stops tracing, writes the remaining spans and closes the trace file. Returns
+ * the number of spans that were dropped because a thread's ring was full.
+ */
+inline auto stop() -> std::uint64_t {
+	auto& s = detail::state();
+	s.enabled.store(false, std::memory_order_release);
+
+	{
+		auto lk = std::scoped_lock{s.writer_mutex};
+		if(s.file == nullptr) {
+			return 0;
+		}
+		s.stopping = true;
+	}
+	s.writer_cv.notify_one();
+	s.writer.join();
+
+	auto lk = std::scoped_lock{s.writer_mutex};
+	auto buffer = std::string{};
+	detail::write_pending(s, buffer);
+	std::fputs("\n]}\n", s.file);
+	std::fclose(s.file);
+	s.file = nullptr;
+	return s.dropped;
+}
+
+/**
+ * Records a span named @p name covering the lifetime of the object while
+ * tracing is running. @p name and @p parent must be static strings.
+ */
+class span {
+	const char*      _name;
+	const char*      _parent;
+	std::int32_t     _entity_count;
+	bool             _enabled;
+	profiling::ticks _start;
+
+public:
+	span(const char* name, const char* parent, std::int32_t entity_count)
+		: _name(name)
+		, _parent(parent)
+		, _entity_count(entity_count)
+		, _enabled(detail::state().enabled.load(std::memory_order_relaxed))
+		, _start(_enabled ? profiling::now() : 0) {
+	}
+
+	span(const span&) = delete;
+	span(span&&) = delete;
+
+	~span() {
+		if(!_enabled) {
+			return;
+		}
+
+		auto end = profiling::now();
+		detail::thread_ring().push(event{
+			.name = _name,
+			.parent = _parent,
+			.entity_count = _entity_count,
+			.start = _start,
+			.duration = end - _start,
+		});
+	}
+};
+
+} // namespace ecsact::trace
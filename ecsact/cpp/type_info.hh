@@ -0,0 +1,92 @@
+#pragma once
+
+#include <tuple>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <string_view>
+#include <type_traits>
+#include "ecsact/runtime/common.h"
+
+namespace ecsact {
+
+/**
+ * Compile time description of a single field of a generated component,
+ * transient or action. Obtained through `C::fields()` which is emitted by the
+ * C++ header code generator.
+ */
+template<typename C, typename T>
+struct field_info {
+	using composite_type = C;
+
+	/** Type of the member. Array fields keep their extent (e.g. `int32_t[4]`) */
+	using member_type = T;
+
+	/** Type of a single element. Same as `member_type` for non-array fields */
+	using value_type = std::remove_all_extents_t<T>;
+
+	ecsact_field_id  id;
+	std::string_view name;
+	T C::*member;
+	std::size_t      offset;
+	ecsact_type_kind kind;
+
+	/**
+	 * Builtin type of the stored value. Field index fields report the builtin
+	 * type of the indexed field. Enums are stored as `int32_t`.
+	 */
+	ecsact_builtin_type builtin;
+
+	/** Array length or 1 for non-array fields */
+	int32_t length;
+
+	/** `true` for `entity` fields */
+	bool entity;
+
+	/** `true` for field index fields */
+	bool field_index;
+
+	constexpr auto get(const C& composite) const -> const T& {
+		return composite.*member;
+	}
+
+	constexpr auto get(C& composite) const -> T& {
+		return composite.*member;
+	}
+};
+
+/**
+ * Set of fields of a generated composite. Bit `i` refers to the `i`th field in
+ * declaration order. Same type as the masks of the generated `diff`,
+ * `delta_size` and `encode_delta` functions.
+ */
+using field_mask = std::uint64_t;
+
+template<typename C>
+concept reflectable = requires {
+	{ C::fields() };
+};
+
+/**
+ * Tuple of `field_info` for every field of @tp C in declaration order.
+ */
+template<reflectable C>
+constexpr auto fields_of() {
+	return C::fields();
+}
+
+template<reflectable C>
+constexpr auto field_count_v = std::tuple_size_v<decltype(C::fields())>;
+
+/**
+ * Invokes @p fn with every `field_info` of @tp C in declaration order.
+ */
+template<reflectable C, typename Fn>
+constexpr auto for_each_field(Fn&& fn) -> void {
+	std::apply(
+		[&](const auto&... info) { (fn(info), ...); },
+		C::fields()
+	);
+}
+
+} // namespace ecsact
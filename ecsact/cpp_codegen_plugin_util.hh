@@ -6,6 +6,9 @@
 #include <string>
 #include <utility>
 #include <concepts>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include "ecsact/codegen/plugin.hh"
 #include "ecsact/runtime/meta.hh"
 
@@ -222,4 +225,255 @@ auto comma_delim(auto&& range) -> std::string {
 	return result;
 }
 
+using soa_batch_column =
+	std::pair<ecsact_component_like_id, ecsact_system_capability>;
+
+/**
+ * Components passed as columns to the SoA batch entry point of a system
+ * (ECSACT_CPP_SOA_BATCH) in column order. Returns an empty list when the
+ * system can't be executed as a batch. Only top level systems without
+ * children, associations, generates or structural/optional capabilities are
+ * eligible.
+ */
+inline auto soa_batch_columns( //
+	ecsact_system_id sys_id
+) -> std::vector<soa_batch_column> {
+	using result_t = std::vector<soa_batch_column>;
+
+	constexpr auto allowed_caps = ECSACT_SYS_CAP_READWRITE |
+		ECSACT_SYS_CAP_INCLUDE | ECSACT_SYS_CAP_EXCLUDE;
+
+	if(ecsact::meta::decl_full_name(sys_id).empty()) {
+		return {};
+	}
+
+	if(ecsact::meta::get_parent_system_id(sys_id).has_value()) {
+		return {};
+	}
+
+	if(!ecsact::meta::get_child_system_ids(sys_id).empty()) {
+		return {};
+	}
+
+	if(!ecsact::meta::system_assoc_ids(sys_id).empty()) {
+		return {};
+	}
+
+	if(!ecsact::meta::get_system_generates_ids(sys_id).empty()) {
+		return {};
+	}
+
+	auto columns = result_t{};
+	for(auto&& [comp_id, cap] : ecsact::meta::system_capabilities(sys_id)) {
+		if((cap & ~allowed_caps) != 0) {
+			return {};
+		}
+
+		if((cap & ECSACT_SYS_CAP_READWRITE) == 0) {
+			continue;
+		}
+
+		auto compo_id = ecsact_id_cast<ecsact_composite_id>(comp_id);
+		if(ecsact_meta_count_fields(compo_id) == 0) {
+			continue;
+		}
+
+		columns.emplace_back(comp_id, cap);
+	}
+
+	return columns;
+}
+
+/**
+ * Components of a system `generates` block paired with whether they are
+ * required or optional.
+ */
+inline auto system_generates_components( //
+	ecsact_system_like_id      sys_like_id,
+	ecsact_system_generates_id gen_id
+) -> std::vector<std::pair<ecsact_component_id, ecsact_system_generate>> {
+	auto count =
+		ecsact_meta_system_generates_components_count(sys_like_id, gen_id);
+	auto comp_ids = std::vector<ecsact_component_id>(count);
+	auto gen_flags = std::vector<ecsact_system_generate>(count);
+	ecsact_meta_system_generates_components(
+		sys_like_id,
+		gen_id,
+		count,
+		comp_ids.data(),
+		gen_flags.data(),
+		nullptr
+	);
+
+	auto result =
+		std::vector<std::pair<ecsact_component_id, ecsact_system_generate>>{};
+	for(auto i = 0; count > i; ++i) {
+		result.emplace_back(comp_ids[i], gen_flags[i]);
+	}
+	return result;
+}
+
+/**
+ * In-memory size and alignment of a single element of a builtin type as
+ * emitted by the C++ header code generator.
+ */
+inline auto builtin_type_size(ecsact_builtin_type type) -> std::size_t {
+	switch(type) {
+		case ECSACT_BOOL:
+		case ECSACT_I8:
+		case ECSACT_U8:
+			return 1;
+		case ECSACT_I16:
+		case ECSACT_U16:
+			return 2;
+		case ECSACT_I32:
+		case ECSACT_U32:
+		case ECSACT_F32:
+		case ECSACT_ENTITY_TYPE:
+			return 4;
+	}
+
+	return 0;
+}
+
+/**
+ * Size of a single element of `field_type` (ignoring array length). Enums are
+ * generated as `enum class` and therefore have the size of `int`.
+ */
+inline auto field_element_size(ecsact_field_type field_type) -> std::size_t {
+	switch(field_type.kind) {
+		case ECSACT_TYPE_KIND_BUILTIN:
+			return builtin_type_size(field_type.type.builtin);
+		case ECSACT_TYPE_KIND_ENUM:
+			return 4;
+		case ECSACT_TYPE_KIND_FIELD_INDEX:
+			return field_element_size(ecsact::meta::get_field_type(
+				field_type.type.field_index.composite_id,
+				field_type.type.field_index.field_id
+			));
+	}
+
+	return 0;
+}
+
+struct field_layout {
+	ecsact_field_id field_id;
+	std::size_t     offset;
+	std::size_t     size;
+	std::size_t     alignment;
+};
+
+struct composite_layout {
+	/** Fields in the order they are emitted */
+	std::vector<field_layout> fields;
+	std::size_t               size;
+	std::size_t               alignment;
+	std::size_t               padding;
+};
+
+/**
+ * Computes the layout of the generated struct for `compo_id`, which keeps the
+ * fields in declaration order. When `packed` is `true` the fields are instead
+ * stable sorted by descending alignment which minimizes padding. Generated
+ * structs never use the packed layout since the runtime copies component data
+ * in declaration order; it is only reported as a suggestion.
+ */
+inline auto get_composite_layout( //
+	ecsact_composite_id compo_id,
+	bool                packed
+) -> composite_layout {
+	auto layout = composite_layout{};
+	layout.alignment = 1;
+
+	for(auto field_id : ecsact::meta::get_field_ids(compo_id)) {
+		auto field_type = ecsact::meta::get_field_type(compo_id, field_id);
+		auto element_size = field_element_size(field_type);
+		auto length = static_cast<std::size_t>(std::max(field_type.length, 1));
+		layout.fields.push_back(field_layout{
+			.field_id = field_id,
+			.offset = 0,
+			.size = element_size * length,
+			.alignment = element_size,
+		});
+	}
+
+	if(packed) {
+		std::ranges::stable_sort(layout.fields, [](auto& a, auto& b) {
+			return a.alignment > b.alignment;
+		});
+	}
+
+	auto data_size = std::size_t{0};
+	auto offset = std::size_t{0};
+	for(auto& field : layout.fields) {
+		offset = (offset + field.alignment - 1) / field.alignment * field.alignment;
+		field.offset = offset;
+		offset += field.size;
+		data_size += field.size;
+		layout.alignment = std::max(layout.alignment, field.alignment);
+	}
+
+	layout.size = (offset + layout.alignment - 1) / layout.alignment *
+		layout.alignment;
+	if(layout.size == 0) {
+		// Empty structs still occupy a byte in C++
+		layout.size = 1;
+	}
+	layout.padding = layout.size - data_size;
+
+	return layout;
+}
+
+/**
+ * 64-bit FNV-1a hash of @p str. Used for hashes computed at codegen time.
+ */
+constexpr auto fnv1a_64(std::string_view str) -> std::uint64_t {
+	auto hash = std::uint64_t{14695981039346656037ull};
+	for(auto c : str) {
+		hash ^= static_cast<std::uint8_t>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+/**
+ * Hash of the in-memory layout of the generated struct for @p compo_id. Covers
+ * the composite name, field names, field types, array lengths, field offsets
+ * and struct size. Two builds with the same hash can exchange the struct bytes
+ * directly (given equal endianness).
+ */
+inline auto get_composite_layout_hash( //
+	ecsact_composite_id compo_id,
+	bool                packed
+) -> std::uint64_t {
+	auto layout = get_composite_layout(compo_id, packed);
+	auto canonical = ecsact::meta::decl_full_name(compo_id) + "{";
+
+	for(auto& field : layout.fields) {
+		auto field_type = ecsact::meta::get_field_type(compo_id, field.field_id);
+		while(field_type.kind == ECSACT_TYPE_KIND_FIELD_INDEX) {
+			auto length = field_type.length;
+			field_type = ecsact::meta::get_field_type(
+				field_type.type.field_index.composite_id,
+				field_type.type.field_index.field_id
+			);
+			field_type.length = length;
+		}
+
+		canonical += ecsact::meta::field_name(compo_id, field.field_id);
+		canonical += ":";
+		if(field_type.kind == ECSACT_TYPE_KIND_ENUM) {
+			canonical += ecsact_meta_enum_name(field_type.type.enum_id);
+		} else {
+			canonical += std::to_string(static_cast<int>(field_type.type.builtin));
+		}
+		canonical += "[" + std::to_string(field_type.length) + "]";
+		canonical += "@" + std::to_string(field.offset) + ";";
+	}
+
+	canonical += "}" + std::to_string(layout.size);
+
+	return fnv1a_64(canonical);
+}
+
 } // namespace ecsact::cpp_codegen_plugin_util
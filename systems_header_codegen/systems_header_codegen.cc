@@ -8,6 +8,7 @@
 #include "ecsact/codegen/plugin.h"
 #include "ecsact/codegen/plugin.hh"
 #include "ecsact/lang-support/lang-cc.hh"
+#include "ecsact/cpp_codegen_plugin_util.hh"
 
 constexpr auto GENERATED_FILE_DISCLAIMER = R"(// GENERATED FILE - DO NOT EDIT
 )";
@@ -78,6 +79,9 @@ static void write_system_impl_fn_decl(
 
 	auto assoc_ids = ecsact::meta::system_assoc_ids(id);
 
+	if(!assoc_ids.empty()) {
+		ctx.writef("#ifndef ECSACT_CPP_CONSTEXPR_ASSOC_IDS\n");
+	}
 	for(auto i = 0; assoc_ids.size() > i; ++i) {
 		auto c_impl_assoc_id_name = std::format("{}__{}", c_impl_fn_name, i);
 		ctx.writef(
@@ -87,6 +91,9 @@ static void write_system_impl_fn_decl(
 			c_impl_assoc_id_name
 		);
 	}
+	if(!assoc_ids.empty()) {
+		ctx.writef("#endif\n");
+	}
 
 	ctx.writef(
 		"ECSACT_EXTERN\n"
@@ -94,6 +101,48 @@ static void write_system_impl_fn_decl(
 		"void {0}(struct ecsact_system_execution_context*);\n",
 		c_impl_fn_name
 	);
+
+	ctx.writef(
+		"ECSACT_EXTERN\n"
+		"ECSACT_EXPORT(\"{0}__batch\")\n"
+		"void {0}__batch(struct ecsact_system_execution_context**, int32_t);\n",
+		c_impl_fn_name
+	);
+}
+
+static void write_system_soa_batch_fn_decl(
+	ecsact::codegen_plugin_context& ctx,
+	ecsact_system_id                sys_id
+) {
+	using ecsact::cc_lang_support::c_identifier;
+	using ecsact::cpp_codegen_plugin_util::soa_batch_columns;
+
+	auto columns = soa_batch_columns(sys_id);
+	if(columns.empty()) {
+		return;
+	}
+
+	auto c_impl_fn_name = c_identifier(ecsact::meta::decl_full_name(sys_id));
+
+	ctx.writef("\n#ifdef ECSACT_CPP_SOA_BATCH\n");
+	ctx.writef(
+		"ECSACT_EXTERN\n"
+		"ECSACT_EXPORT(\"{0}__soa_columns\")\n"
+		"const ecsact_component_like_id {0}__soa_columns[{1}];\n",
+		c_impl_fn_name,
+		columns.size()
+	);
+	ctx.writef(
+		"ECSACT_EXTERN\n"
+		"ECSACT_EXPORT(\"{0}__soa\")\n"
+		"void {0}__soa(\n"
+		"\tint32_t                 entity_count,\n"
+		"\tconst ecsact_entity_id* entities,\n"
+		"\tvoid* const*            columns\n"
+		");\n",
+		c_impl_fn_name
+	);
+	ctx.writef("#endif\n");
 }
 
 void ecsact_codegen_plugin(
@@ -120,6 +169,10 @@ void ecsact_codegen_plugin(
 		write_system_impl_fn_decl(ctx, sys_id);
 	}
 
+	for(auto sys_id : get_system_ids(ctx.package_id)) {
+		write_system_soa_batch_fn_decl(ctx, sys_id);
+	}
+
 	ctx.writef("\n");
 	ctx.writef("#endif // {}\n", inc_guard_str);
 }
@@ -0,0 +1,95 @@
+#define ECSACT_CPP_MOCK_RUNTIME_IMPLEMENTATION
+#include "ecsact/cpp/mock_runtime.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include "example.ecsact.systems.hh"
+#include "example.ecsact.systems.h"
+
+namespace mock = ecsact::mock;
+
+int main(int argc, char* argv[]) {
+	auto entity_count = std::size_t{100'000};
+	if(argc > 1) {
+		// last so `bazel run` arguments override the test's own
+		entity_count = std::strtoull(argv[argc - 1], nullptr, 10);
+	}
+
+	auto world = mock::world{};
+	world.create_entities(
+		entity_count,
+		pkg::a::ExampleA{.a = 0},
+		pkg::b::ExampleB{.b = 0}
+	);
+
+	mock::run_system<
+		example::ExampleSystemFromImports,
+		pkg::a::ExampleA,
+		pkg::b::ExampleB>(world, &example__ExampleSystemFromImports);
+	if(world.get<pkg::a::ExampleA>(0).a != 1) {
+		std::fprintf(stderr, "ExampleSystemFromImports did not update ExampleA\n");
+		return 1;
+	}
+
+	// matched once so the benchmarks only time the system executions
+	auto from_imports_entities = mock::match_entities<
+		example::ExampleSystemFromImports,
+		pkg::a::ExampleA,
+		pkg::b::ExampleB>(world);
+	auto lazy_entities =
+		mock::match_entities<example::ExampleLazy, pkg::a::ExampleA>(world);
+
+	auto results = {
+		std::pair{
+			"example.ExampleSystemFromImports",
+			mock::benchmark(
+				20,
+				[&] {
+					return mock::run_system(
+						world,
+						from_imports_entities,
+						&example__ExampleSystemFromImports
+					);
+				}
+			),
+		},
+		std::pair{
+			"example.ExampleSystemFromImports (batch)",
+			mock::benchmark(
+				20,
+				[&] {
+					return mock::run_system_batch(
+						world,
+						from_imports_entities,
+						&example__ExampleSystemFromImports__batch
+					);
+				}
+			),
+		},
+		std::pair{
+			"example.ExampleLazy",
+			mock::benchmark(
+				20,
+				[&] {
+					return mock::run_system(
+						world,
+						lazy_entities,
+						&example__ExampleLazy
+					);
+				}
+			),
+		},
+	};
+
+	for(auto&& [name, result] : results) {
+		std::printf(
+			"%s: %zu entities, median %lld ns, %.2f ns/entity\n",
+			name,
+			result.executions,
+			static_cast<long long>(result.median.count()),
+			result.per_execution().count()
+		);
+	}
+
+	return 0;
+}
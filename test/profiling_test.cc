@@ -0,0 +1,42 @@
+#include "ecsact/cpp/profiling.hh"
+
+#include <iostream>
+
+namespace profiling = ecsact::profiling;
+
+static auto check_percentile(
+	const profiling::histogram& h,
+	double                      p,
+	profiling::ticks            expected
+) -> bool {
+	auto actual = h.percentile(p);
+	if(actual != expected) {
+		std::cerr << "percentile(" << p << ") = " << actual << ", expected "
+							<< expected << "\n";
+		return false;
+	}
+	return true;
+}
+
+auto main() -> int {
+	auto ok = true;
+
+	ok &= check_percentile(profiling::histogram{}, 0.5, 0);
+
+	// durations below the sub bucket count get a bucket each
+	auto h = profiling::histogram{};
+	for(auto t = profiling::ticks{1}; 4 >= t; ++t) {
+		h.add(t);
+	}
+
+	// nearest rank: ceil(p * 4) clamped to [1, 4]
+	ok &= check_percentile(h, 0.0, 1);
+	ok &= check_percentile(h, 0.25, 1);
+	ok &= check_percentile(h, 0.26, 2);
+	ok &= check_percentile(h, 0.5, 2);
+	ok &= check_percentile(h, 0.51, 3);
+	ok &= check_percentile(h, 0.99, 4);
+	ok &= check_percentile(h, 1.0, 4);
+
+	return ok ? 0 : 1;
+}
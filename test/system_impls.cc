@@ -1,3 +1,4 @@
+#include <array>
 #include "example.ecsact.systems.hh"
 
 void example::ExampleIndexedAction::impl(context& ctx) {
@@ -14,6 +15,19 @@ void example::ExampleSystemFromImports::impl(context& ctx) {
 	ctx.update(b);
 }
 
+#if defined(ECSACT_CPP_SOA_BATCH) && \
+	defined(ECSACT_CPP_SOA_BATCH_example__ExampleSystemFromImports)
+void example::ExampleSystemFromImports::batch_impl(batch_context& ctx) {
+	// same as impl for a whole chunk of entities at once
+	for(auto& a : ctx.column<pkg::a::ExampleA>()) {
+		a.a += 1;
+	}
+	for(auto& b : ctx.column<pkg::b::ExampleB>()) {
+		b.b += 1;
+	}
+}
+#endif
+
 void example::ExampleLazy::impl(context&) {
 }
 
@@ -29,6 +43,55 @@ void example::ExplicitlyNoLazyZero::impl(context&) {
 void example::ParallelExample::impl(context&) {
 }
 
+void example::ReadonlyViewExample::impl(context& ctx) {
+	// readonly components can be viewed without copying when the runtime
+	// supports it
+	const auto b = ctx.view<pkg::b::ExampleB>();
+
+	auto a = ctx.get<pkg::a::ExampleA>();
+	a.a = b->b;
+	ctx.update(a);
+}
+
+void example::GeneratesExample::impl(context& ctx) {
+	auto a = ctx.get<pkg::a::ExampleA>();
+	ctx.generate(a);
+
+	// many entities with the same components
+	ctx.generate_n(16, a, pkg::b::ExampleB{.b = a.a});
+
+	// one entity per element of each array
+	auto as = std::array<pkg::a::ExampleA, 4>{};
+	auto bs = std::array<pkg::b::ExampleB, 4>{};
+	ctx.generate_batch<pkg::a::ExampleA, pkg::b::ExampleB>(as, bs);
+}
+
+void example::AssocAccessorExample::impl(context& ctx) {
+	// assoc fields are given once and reused for every access
+	auto indexed = ctx.assoc<ExampleIndexedComponent>(int32_t{0});
+	auto comp = indexed.get();
+	comp.some_indexed_field += 1;
+	indexed.update(comp);
+}
+
+void example::GetManyExample::impl(context& ctx) {
+	// several components read and written with one call each
+	auto [a, b] = ctx.get_many<pkg::a::ExampleA, pkg::b::ExampleB>();
+
+	a.a += 1;
+	b.b += 1;
+
+	ctx.update_many(a, b);
+}
+
+void example::ModifyExample::impl(context& ctx) {
+	// only written back to the runtime if the component actually changed
+	auto a = ctx.modify<pkg::a::ExampleA>();
+	if(a->a < 0) {
+		a->a = 0;
+	}
+}
+
 // mock association id for sake of test
 const ecsact_system_assoc_id example__AssocSystemExample__0 = {};
 
@@ -73,3 +136,21 @@ void example::AssocSystemMultiExample::impl(context& ctx) {
 	// context 1 can access ExampleB
 	auto assoc_b = other_ctx_1.get<pkg::b::ExampleB>();
 }
+
+void example::ActionPayloadExample::impl(context& ctx) {
+	// the payload is fetched from the runtime once per context
+	const auto& action = ctx.action();
+	if(action.amount > 0) {
+		auto a = ctx.get<pkg::a::ExampleA>();
+		a.a += ctx.action().amount;
+		ctx.update(a);
+	}
+}
+
+void example::ActionPayloadExample::ActionPayloadChild::impl(context& ctx) {
+	// the parent context is kept in ctx so the reference stays valid
+	const auto& action = ctx.parent().action();
+	auto        b = ctx.get<pkg::b::ExampleB>();
+	b.b += action.amount;
+	ctx.update(b);
+}